@@ -1,52 +1,30 @@
 #include "common.h"
+#include "expression.h"
 
 int main() {
     print_separator("简单计算器");
-    
-    double num1, num2;
-    char operation;
-    
-    cout << "请输入第一个数字: ";
-    cin >> num1;
-    
-    cout << "请输入运算符 (+, -, *, /): ";
-    cin >> operation;
-    
-    cout << "请输入第二个数字: ";
-    cin >> num2;
-    
-    double result = 0;
-    bool validOperation = true;
-    
-    switch (operation) {
-        case '+':
-            result = num1 + num2;
-            break;
-        case '-':
-            result = num1 - num2;
-            break;
-        case '*':
-            result = num1 * num2;
-            break;
-        case '/':
-            if (num2 != 0) {
-                result = num1 / num2;
-            } else {
-                cout << "错误：除数不能为零！" << endl;
-                validOperation = false;
-            }
-            break;
-        default:
-            cout << "错误：无效的运算符！" << endl;
-            validOperation = false;
-    }
-    
-    if (validOperation) {
-        cout << "\n计算结果：" << endl;
-        cout << num1 << " " << operation << " " << num2 << " = " << result << endl;
+
+    // 整个表达式一次解析成字节码再求值，而不是逐个运算符地 switch
+    string line;
+    cout << "请输入表达式 (支持 +, -, *, / 和括号，例如 3 + 4 * (2 - 1)): ";
+    getline(cin, line);
+
+    try {
+        Expression expression(line);
+        double result = expression.evaluate();
+
+        // 字节码按 IEEE 规则求值，除以零、溢出等都表现为 inf/NaN，这里统一报告
+        if (!std::isfinite(result)) {
+            cout << "错误：结果不是有限数（除数为零或数值溢出）！" << endl;
+        } else {
+            cout << "\n计算结果：" << endl;
+            cout << line << " = " << result << endl;
+        }
+    } catch (const std::invalid_argument& e) {
+        cout << "错误：无效的表达式！" << e.what() << endl;
     }
-    
+
     print_separator("计算器演示完成");
-    
+
     return 0;
-} 
\ No newline at end of file
+}
@@ -1,5 +1,30 @@
 #include "common.h"
 #include <functional>
+#include <future>
+#include <condition_variable>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include "function_wrappers.h"
+#include "combinators.h"
+#include "memoize.h"
+
+using std::function;
+using std::tuple;
+using std::thread;
+using std::forward;
+using std::enable_if;
+using std::is_integral;
+using std::is_floating_point;
+using std::promise;
+using std::future;
+using std::async;
+using std::launch;
+using std::bind;
+namespace placeholders = std::placeholders;
+namespace this_thread = std::this_thread;
+namespace chrono = std::chrono;
 
 // 1. Lambda表达式详解
 void lambda_examples() {
@@ -53,7 +78,10 @@ void std_function_examples() {
     cout << "\n=== std::function详解 ===" << endl;
     
     // 存储不同类型的可调用对象
-    vector<function<int(int, int)>> operations;
+    // inplace_function 与 std::function 用法相同，但可调用对象放在 48 字节的内联缓冲区中，
+    // 不会分配堆内存（bind 成员函数的结果约 24 字节）
+    using Operation = inplace_function<int(int, int), 48>;
+    vector<Operation> operations;
     
     // 普通函数
     operations.push_back([](int a, int b) { return a + b; });
@@ -76,14 +104,20 @@ void std_function_examples() {
     Calculator calc;
     operations.push_back(bind(&Calculator::divide, &calc, placeholders::_1, placeholders::_2));
     
-    // 执行所有操作
+    // 执行所有操作：以 function_ref 传参，不拷贝、不拥有被调用对象
+    auto run = [](const string& name, function_ref<int(int, int)> op) {
+        cout << name << ": 12, 3 = " << op(12, 3) << endl;
+    };
     string names[] = {"加法", "减法", "乘法", "除法"};
     for (size_t i = 0; i < operations.size(); i++) {
-        cout << names[i] << ": 12, 3 = " << operations[i](12, 3) << endl;
+        run(names[i], operations[i]);
     }
+    cout << "sizeof(std::function<int(int,int)>) = " << sizeof(function<int(int, int)>)
+         << ", sizeof(Operation) = " << sizeof(Operation)
+         << ", sizeof(function_ref<int(int,int)>) = " << sizeof(function_ref<int(int, int)>) << endl;
     
     // 条件回调
-    function<void(const string&)> logger;
+    inplace_function<void(const string&)> logger;
     
     bool debug_mode = true;
     if (debug_mode) {
@@ -125,115 +159,537 @@ auto reduce(const Container& container, Accumulator init, BinaryOp op) {
     return result;
 }
 
+// 惰性流水线：filter/map/take 只记录阶段，直到 reduce/to_vector/first/any_of 等终结操作时
+// 才在一趟循环中融合执行全部阶段，不产生任何中间容器
+namespace lazy {
+
+template<typename T>
+struct SpanSource {
+    using value_type = T;
+    const T* data;
+    size_t count;
+    size_t size() const { return count; }
+    T operator[](size_t i) const { return data[i]; }
+};
+
+// 不占内存的整数序列 start, start+1, ...
+template<typename T>
+struct IotaSource {
+    using value_type = T;
+    T start;
+    size_t count;
+    size_t size() const { return count; }
+    T operator[](size_t i) const { return static_cast<T>(start + static_cast<T>(i)); }
+};
+
+template<typename Pred> struct FilterStage { Pred pred; };
+template<typename Func> struct MapStage { Func func; };
+struct TakeStage { size_t count; };
+template<typename Pred> struct TakeWhileStage { Pred pred; };
+
+template<typename S> struct is_filter : std::false_type {};
+template<typename P> struct is_filter<FilterStage<P>> : std::true_type {};
+template<typename S> struct is_map : std::false_type {};
+template<typename F> struct is_map<MapStage<F>> : std::true_type {};
+
+// 执行策略
+struct Sequential {};
+struct Parallel { unsigned threads = 0; };
+inline constexpr Sequential seq{};
+inline Parallel par(unsigned threads = 0) { return Parallel{threads}; }
+
+// 并行查找时每块元素先求值到栈上缓冲区再检查，块也是检查提前结束标志的粒度
+constexpr size_t kChunkSize = 256;
+
+template<typename Source, typename... Stages>
+class Pipeline {
+private:
+    using StageTuple = std::tuple<Stages...>;
+    
+    Source source;
+    StageTuple stages;
+    
+    // take/take_while 的结果依赖元素顺序，含有它们时走逐元素的短路路径
+    static constexpr bool kShortCircuit = ((!is_filter<Stages>::value && !is_map<Stages>::value) || ...);
+    
+    // 所有 map 都在 filter 之前时，map 处理的本来就是全部元素，可以先算完再用 keep 标志筛选；
+    // 否则 filter 必须挡住其后的阶段（例如 filter(x != 0).map(100 / x)），只能逐元素推入
+    static constexpr bool maps_before_filters() {
+        constexpr bool filters[] = {false, is_filter<Stages>::value...};
+        constexpr bool maps[] = {false, is_map<Stages>::value...};
+        bool seen_filter = false;
+        for (size_t i = 0; i <= sizeof...(Stages); ++i) {
+            seen_filter = seen_filter || filters[i];
+            if (seen_filter && maps[i]) return false;
+        }
+        return true;
+    }
+    static constexpr bool kBranchFree = !kShortCircuit && maps_before_filters();
+    
+    template<typename Stage>
+    auto append(Stage stage) const {
+        return Pipeline<Source, Stages..., Stage>(source, std::tuple_cat(stages, std::make_tuple(std::move(stage))));
+    }
+    
+    // 只在 kBranchFree 时用于求值：map 作用于每个元素，filter 更新 keep 标志，
+    // 后面的 filter 只在 keep 仍为 true 时才调用，循环体里没有提前跳出，利于向量化。
+    // 其他情况下只借助它推导输出类型
+    template<size_t I, typename V>
+    auto evaluate(V value, bool& keep) const {
+        if constexpr (I == sizeof...(Stages)) {
+            return value;
+        } else if constexpr (is_filter<std::tuple_element_t<I, StageTuple>>::value) {
+            keep = keep && static_cast<bool>(std::get<I>(stages).pred(value));
+            return evaluate<I + 1>(value, keep);
+        } else if constexpr (is_map<std::tuple_element_t<I, StageTuple>>::value) {
+            return evaluate<I + 1>(std::get<I>(stages).func(value), keep);
+        } else {
+            return evaluate<I + 1>(value, keep);  // take 类阶段不改变元素类型
+        }
+    }
+    
+    using output_type = std::decay_t<decltype(std::declval<const Pipeline&>().template evaluate<0>(
+        std::declval<typename Source::value_type>(), std::declval<bool&>()))>;
+    
+    // 逐元素推入各阶段，sink 或 take 返回 false 时立即停止
+    template<size_t I, typename V, typename Sink>
+    static bool push(StageTuple& state, V value, Sink& sink) {
+        if constexpr (I == sizeof...(Stages)) {
+            return sink(value);
+        } else {
+            using Stage = std::tuple_element_t<I, StageTuple>;
+            auto& stage = std::get<I>(state);
+            if constexpr (is_filter<Stage>::value) {
+                return !stage.pred(value) || push<I + 1>(state, value, sink);
+            } else if constexpr (is_map<Stage>::value) {
+                return push<I + 1>(state, stage.func(value), sink);
+            } else if constexpr (std::is_same_v<Stage, TakeStage>) {
+                if (stage.count == 0) return false;
+                --stage.count;
+                return push<I + 1>(state, value, sink) && stage.count > 0;
+            } else {
+                return stage.pred(value) && push<I + 1>(state, value, sink);
+            }
+        }
+    }
+    
+    // 逐元素执行 [begin, end)，每次执行复制一份阶段状态，take 的计数器从头开始
+    template<typename Sink>
+    void run_range(size_t begin, size_t end, Sink& sink) const {
+        StageTuple state = stages;
+        for (size_t i = begin; i < end; ++i) {
+            if (!push<0>(state, source[i], sink)) return;
+        }
+    }
+    
+    template<typename Sink>
+    void run(Sink& sink) const {
+        run_range(0, source.size(), sink);
+    }
+    
+    // 分块执行 [begin, end)：visit(values, keep, count) 处理一块求值结果，返回 false 时停止
+    template<typename Visit>
+    void for_each_chunk(size_t begin, size_t end, Visit& visit) const {
+        output_type values[kChunkSize];
+        bool keep[kChunkSize];
+        for (size_t base = begin; base < end; base += kChunkSize) {
+            size_t count = std::min(kChunkSize, end - base);
+            for (size_t j = 0; j < count; ++j) {
+                bool k = true;
+                values[j] = evaluate<0>(source[base + j], k);
+                keep[j] = k;
+            }
+            if (!visit(values, keep, count)) return;
+        }
+    }
+    
+    // 归约直接在一个循环内求值并折叠：对简单的 op，这比先写缓冲区再折叠更快
+    template<typename Acc, typename Op>
+    Acc reduce_range(size_t begin, size_t end, Acc acc, Op& op) const {
+        if constexpr (kBranchFree) {
+            for (size_t i = begin; i < end; ++i) {
+                bool keep = true;
+                auto value = evaluate<0>(source[i], keep);
+                acc = keep ? op(acc, value) : acc;
+            }
+        } else {
+            auto sink = [&](const auto& value) { acc = op(acc, value); return true; };
+            run_range(begin, end, sink);
+        }
+        return acc;
+    }
+    
+    static unsigned thread_count(Parallel policy, size_t n) {
+        unsigned threads = policy.threads ? policy.threads : std::max(1u, std::thread::hardware_concurrency());
+        size_t chunks = (n + kChunkSize - 1) / kChunkSize;
+        return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, chunks)));
+    }
+    
+    // 把 [0, n) 均分给各线程，主线程处理第一段
+    template<typename Task>
+    static void fork_join(unsigned threads, size_t n, Task task) {
+        vector<thread> workers;
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back([&task, t, threads, n] { task(t, n * t / threads, n * (t + 1) / threads); });
+        }
+        task(0, 0, n / threads);
+        for (auto& worker : workers) worker.join();
+    }
+    
+public:
+    Pipeline(Source source, StageTuple stages) : source(source), stages(std::move(stages)) {}
+    
+    template<typename Pred>
+    auto filter(Pred pred) const { return append(FilterStage<Pred>{pred}); }
+    
+    template<typename Func>
+    auto map(Func func) const { return append(MapStage<Func>{func}); }
+    
+    auto take(size_t count) const { return append(TakeStage{count}); }
+    
+    template<typename Pred>
+    auto take_while(Pred pred) const { return append(TakeWhileStage<Pred>{pred}); }
+    
+    template<typename Acc, typename Op>
+    Acc reduce(Acc init, Op op) const { return reduce(seq, init, op); }
+    
+    template<typename Acc, typename Op>
+    Acc reduce(Sequential, Acc init, Op op) const {
+        return reduce_range(0, source.size(), init, op);
+    }
+    
+    // 各线程从 init 开始归约自己的区间，再用 op 合并部分结果：
+    // 要求 op 满足结合律、init 是 op 的单位元，且 op 能接受两个累加值
+    template<typename Acc, typename Op>
+    Acc reduce(Parallel policy, Acc init, Op op) const {
+        static_assert(!kShortCircuit, "take/take_while 依赖元素顺序，不能并行执行");
+        size_t n = source.size();
+        unsigned threads = thread_count(policy, n);
+        vector<std::optional<Acc>> partial(threads);
+        fork_join(threads, n, [&](unsigned t, size_t begin, size_t end) {
+            Op local_op = op;
+            partial[t] = reduce_range(begin, end, init, local_op);
+        });
+        Acc result = *partial[0];
+        for (unsigned t = 1; t < threads; ++t) result = op(result, *partial[t]);
+        return result;
+    }
+    
+    template<typename Func>
+    void for_each(Func func) const {
+        auto sink = [&](const auto& value) { func(value); return true; };
+        run(sink);
+    }
+    
+    vector<output_type> to_vector() const {
+        vector<output_type> result;
+        auto sink = [&](const auto& value) { result.push_back(value); return true; };
+        run(sink);
+        return result;
+    }
+    
+    std::optional<output_type> first() const {
+        std::optional<output_type> result;
+        auto sink = [&](const auto& value) { result = value; return false; };
+        run(sink);
+        return result;
+    }
+    
+    template<typename Pred>
+    bool any_of(Pred pred) const {
+        return filter(pred).first().has_value();
+    }
+    
+    // 并行查找：任一线程命中后置位标志，其他线程在下一块开始前退出
+    template<typename Pred>
+    bool any_of(Parallel policy, Pred pred) const {
+        static_assert(!kShortCircuit, "take/take_while 依赖元素顺序，不能并行执行");
+        size_t n = source.size();
+        std::atomic<bool> found{false};
+        fork_join(thread_count(policy, n), n, [&](unsigned, size_t begin, size_t end) {
+            if constexpr (!kBranchFree) {
+                auto sink = [&](const auto& value) {
+                    if (found.load(std::memory_order_relaxed)) return false;
+                    if (!pred(value)) return true;
+                    found.store(true, std::memory_order_relaxed);
+                    return false;
+                };
+                run_range(begin, end, sink);
+            } else {
+                auto scan = [&](const output_type* values, const bool* keep, size_t count) {
+                    if (found.load(std::memory_order_relaxed)) return false;
+                    bool hit = false;
+                    for (size_t j = 0; j < count; ++j) {
+                        hit |= keep[j] && pred(values[j]);
+                    }
+                    if (hit) found.store(true, std::memory_order_relaxed);
+                    return !hit;
+                };
+                for_each_chunk(begin, end, scan);
+            }
+        });
+        return found.load();
+    }
+};
+
+// 流水线只保存容器的地址，容器必须比流水线活得久；临时容器会立即销毁，因此禁止
+template<typename T>
+auto from(const vector<T>& container) {
+    return Pipeline<SpanSource<T>>(SpanSource<T>{container.data(), container.size()}, {});
+}
+
+template<typename T>
+auto from(const vector<T>&& container) = delete;
+
+template<typename T>
+auto iota(T start, size_t count) {
+    return Pipeline<IotaSource<T>>(IotaSource<T>{start, count}, {});
+}
+
+} // namespace lazy
+
 void functional_programming_examples() {
     cout << "\n=== 函数式编程技术 ===" << endl;
     
     vector<int> numbers = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     
     cout << "原始数组: ";
-    for (int n : numbers) cout << n << " ";
+    lazy::from(numbers).for_each([](int n) { cout << n << " "; });
     cout << endl;
     
     // Filter: 过滤偶数
-    auto evens = filter(numbers, [](int n) { return n % 2 == 0; });
+    auto evens = lazy::from(numbers).filter([](int n) { return n % 2 == 0; }).to_vector();
     cout << "偶数: ";
     for (int n : evens) cout << n << " ";
     cout << endl;
     
     // Map: 平方
-    auto squares = map(numbers, [](int n) { return n * n; });
+    auto squares = lazy::from(numbers).map([](int n) { return n * n; }).to_vector();
     cout << "平方: ";
     for (int n : squares) cout << n << " ";
     cout << endl;
     
     // Reduce: 求和
-    auto sum = reduce(numbers, 0, [](int acc, int n) { return acc + n; });
+    auto sum = lazy::from(numbers).reduce(0, [](int acc, int n) { return acc + n; });
     cout << "求和: " << sum << endl;
     
-    // 链式操作
-    auto result = reduce(
-        map(
-            filter(numbers, [](int n) { return n % 2 == 1; }),  // 奇数
-            [](int n) { return n * n; }                         // 平方
-        ),
-        0,
-        [](int acc, int n) { return acc + n; }                 // 求和
-    );
+    // 链式操作：三个阶段融合成一趟循环，没有中间数组
+    auto result = lazy::from(numbers)
+        .filter([](int n) { return n % 2 == 1; })   // 奇数
+        .map([](int n) { return n * n; })           // 平方
+        .reduce(0, [](int acc, int n) { return acc + n; });  // 求和
     cout << "奇数平方和: " << result << endl;
+    
+    // filter 挡住其后的阶段：被过滤掉的 0 不会进入除法
+    vector<int> with_zeros = {0, 1, 2, 0, 4};
+    auto inverse_sum = lazy::from(with_zeros)
+        .filter([](int n) { return n != 0; })
+        .map([](int n) { return 100 / n; })
+        .reduce(0LL, [](long long acc, int n) { return acc + n; });
+    cout << "非零元素 100/n 之和: " << inverse_sum << endl;
+    
+    // 提前结束：只处理到第 3 个满足条件的元素
+    cout << "前 3 个大于 20 的平方: ";
+    lazy::from(numbers)
+        .map([](int n) { return n * n; })
+        .filter([](int n) { return n > 20; })
+        .take(3)
+        .for_each([](int n) { cout << n << " "; });
+    cout << endl;
+    
+    auto first_big = lazy::iota(1, 1000000).map([](int n) { return n * n; }).filter([](int n) { return n > 1000; }).first();
+    cout << "第一个大于 1000 的平方数: " << first_big.value_or(-1) << endl;
+    
+    // map 全部在 filter 之前：先整块求值再按 keep 标志筛选，没有分支；结果与逐元素推入一致
+    auto squares_mod_7 = lazy::iota(1, 10000)
+        .map([](int n) { return static_cast<long long>(n) * n; })
+        .filter([](long long v) { return v % 7 == 0; });
+    long long branch_free_sum = squares_mod_7.reduce(0LL, [](long long a, long long b) { return a + b; });
+    long long pushed_sum = 0;
+    squares_mod_7.for_each([&](long long v) { pushed_sum += v; });
+    bool parallel_hit = squares_mod_7.any_of(lazy::par(), [](long long v) { return v == 9996LL * 9996; });
+    bool pushed_hit = squares_mod_7.any_of([](long long v) { return v == 9996LL * 9996; });
+    cout << "map → filter 分块求值: 7 的倍数的平方和 " << branch_free_sum
+         << ", 并行查找 " << (parallel_hit ? "命中" : "未命中")
+         << ", 与逐元素推入一致: " << (branch_free_sum == pushed_sum && parallel_hit == pushed_hit ? "是" : "否") << endl;
+    
+    auto parallel_sum = lazy::iota(1, 100000)
+        .map([](int n) { return static_cast<long long>(n); })
+        .reduce(lazy::par(), 0LL, [](long long a, long long b) { return a + b; });
+    cout << "并行求和 1..100000: " << parallel_sum << endl;
 }
 
-// 4. 高阶函数
-template<typename Func>
-auto curry(Func func) {
-    return [func](auto first) {
-        return [func, first](auto... rest) {
-            return func(first, rest...);
-        };
+// 链式 filter → map → reduce：逐级生成中间容器 vs 融合流水线
+void benchmark_pipeline(size_t n) {
+    cout << "\n=== 流水线融合性能对比 (" << n << " 个元素) ===" << endl;
+    
+    vector<int> data(n);
+    for (size_t i = 0; i < n; ++i) data[i] = static_cast<int>(i % 1000);
+    
+    auto is_odd = [](int x) { return x % 2 != 0; };
+    auto square = [](int x) { return static_cast<long long>(x) * x; };
+    auto plus = [](long long a, long long b) { return a + b; };
+    
+    auto measure = [](const string& desc, auto func) {
+        auto start = chrono::high_resolution_clock::now();
+        auto result = func();
+        auto end = chrono::high_resolution_clock::now();
+        cout << "  " << desc << ": " << chrono::duration_cast<chrono::milliseconds>(end - start).count()
+             << " ms (结果 " << result << ")" << endl;
     };
+    
+    measure("逐级生成容器", [&] { return reduce(map(filter(data, is_odd), square), 0LL, plus); });
+    measure("手写循环", [&] {
+        long long sum = 0;
+        for (int x : data) {
+            if (is_odd(x)) sum += square(x);
+        }
+        return sum;
+    });
+    measure("lazy 顺序", [&] { return lazy::from(data).filter(is_odd).map(square).reduce(0LL, plus); });
+    measure("lazy 并行", [&] { return lazy::from(data).filter(is_odd).map(square).reduce(lazy::par(), 0LL, plus); });
+    
+    // 提前结束：999 的平方在前 1000 个元素内就出现，逐级版本仍要处理全部数据
+    measure("逐级生成容器 查找首个平方 >= 998001", [&] {
+        auto squares = map(filter(data, is_odd), square);
+        return std::find_if(squares.begin(), squares.end(), [](long long v) { return v >= 998001; }) != squares.end();
+    });
+    measure("lazy 查找首个平方 >= 998001", [&] {
+        return lazy::from(data).filter(is_odd).map(square).any_of([](long long v) { return v >= 998001; });
+    });
+    measure("lazy 并行查找不存在的值", [&] {
+        return lazy::from(data).filter(is_odd).map(square).any_of(lazy::par(), [](long long v) { return v < 0; });
+    });
+    
+    // map → filter：全部 map 在 filter 之前，reduce 与并行 any_of 走无分支的分块求值，
+    // 与逐元素推入的 for_each / 顺序 any_of 对照
+    auto is_odd_square = [](long long v) { return v % 2 != 0; };
+    auto squared_odds = lazy::from(data).map(square).filter(is_odd_square);
+    long long missing = 1000001LL + (data.empty() ? 0 : data.back());  // 大于 999 的平方，运行时才知道，编译器无法折叠查找
+    long long chunked_sum = 0, pushed_sum = 0;
+    bool chunked_hit = true, pushed_hit = true;
+    measure("map → filter 逐元素推入", [&] {
+        squared_odds.for_each([&](long long v) { pushed_sum += v; });
+        return pushed_sum;
+    });
+    measure("map → filter 无分支归约", [&] { return chunked_sum = squared_odds.reduce(0LL, plus); });
+    measure("map → filter 并行无分支归约", [&] { return squared_odds.reduce(lazy::par(), 0LL, plus); });
+    measure("map → filter 顺序查找不存在的值", [&] {
+        return pushed_hit = squared_odds.any_of([missing](long long v) { return v == missing; });
+    });
+    measure("map → filter 并行分块查找不存在的值", [&] {
+        return chunked_hit = squared_odds.any_of(lazy::par(), [missing](long long v) { return v == missing; });
+    });
+    cout << "  分块求值与逐元素推入结果一致: "
+         << (chunked_sum == pushed_sum && chunked_hit == pushed_hit ? "是" : "否") << endl;
 }
 
-template<typename Func1, typename Func2>
-auto compose(Func1 f, Func2 g) {
-    return [f, g](auto x) {
-        return f(g(x));
-    };
-}
+// 4. 高阶函数
+// curry 与 compose 见 common/combinators.h：constexpr、空基类优化，组合后可完整内联
 
-template<typename Func>
-auto memoize(Func func) {
-    return [func](auto... args) mutable {
-        static map<tuple<decltype(args)...>, decltype(func(args...))> cache;
-        
-        auto key = make_tuple(args...);
-        if (cache.find(key) != cache.end()) {
-            cout << "  从缓存获取结果" << endl;
-            return cache[key];
-        }
-        
-        cout << "  计算新结果" << endl;
-        auto result = func(args...);
-        cache[key] = result;
-        return result;
-    };
-}
+// 记忆化（TupleHash、Memoizer、memoize）见 common/memoize.h
 
 void higher_order_functions() {
     cout << "\n=== 高阶函数 ===" << endl;
     
     // 柯里化
-    auto add = [](int a, int b, int c) { return a + b + c; };
-    auto curried_add = curry(add);
-    auto add_5 = curried_add(5);
-    auto add_5_3 = add_5(3);
+    constexpr auto add = [](int a, int b, int c) { return a + b + c; };
+    constexpr auto curried_add = curry(add);
+    constexpr auto add_5 = curried_add(5);
+    constexpr auto add_5_3 = add_5(3);
     
     cout << "柯里化: curried_add(5)(3)(2) = " << add_5_3(2) << endl;
+    static_assert(add_5_3(2) == 10, "柯里化可在编译期求值");
+    static_assert(curried_add(5, 3)(2) == 10, "一次可绑定多个参数");
+    // 只保存已绑定的参数，被柯里化的无捕获 lambda 不占空间
+    static_assert(sizeof(curried_add) == 1, "无状态时大小为 1");
+    static_assert(sizeof(add_5) == sizeof(int), "绑定一个 int");
+    static_assert(sizeof(add_5_3) == 2 * sizeof(int), "绑定两个 int");
     
     // 函数组合
-    auto square = [](int x) { return x * x; };
-    auto add_one = [](int x) { return x + 1; };
-    auto square_then_add_one = compose(add_one, square);
-    auto add_one_then_square = compose(square, add_one);
+    constexpr auto square = [](int x) { return x * x; };
+    constexpr auto add_one = [](int x) { return x + 1; };
+    constexpr auto square_then_add_one = compose(add_one, square);
+    constexpr auto add_one_then_square = compose(square, add_one);
     
     cout << "组合函数1: square_then_add_one(3) = " << square_then_add_one(3) << endl;
     cout << "组合函数2: add_one_then_square(3) = " << add_one_then_square(3) << endl;
-    
-    // 记忆化
-    function<long long(int)> fib = [](int n) -> long long {
+    static_assert(square_then_add_one(3) == 10 && add_one_then_square(3) == 16, "组合可在编译期求值");
+    static_assert(sizeof(square_then_add_one) == 1, "组合两个无状态 lambda 不占空间");
+    
+    // 有状态时，组合结果的大小就是状态本身
+    int offset = 7;
+    auto add_offset = [offset](int x) { return x + offset; };
+    auto square_then_offset = compose(add_offset, square);
+    static_assert(sizeof(square_then_offset) == sizeof(add_offset), "只保存 offset");
+    cout << "带状态组合: square_then_offset(3) = " << square_then_offset(3)
+         << ", sizeof = " << sizeof(square_then_offset) << endl;
+    
+    // 记忆化：fib_impl 通过 self 递归，内部调用同样命中缓存
+    auto memo_fib = memoize<long long, int>([](auto& fib_impl, int n) -> long long {
         if (n <= 1) return n;
-        return fib(n - 1) + fib(n - 2);
-    };
-    
-    auto memo_fib = memoize([](int n) -> long long {
-        function<long long(int)> fib_impl = [](int n) -> long long {
-            if (n <= 1) return n;
-            return fib_impl(n - 1) + fib_impl(n - 2);
-        };
-        return fib_impl(n);
+        return fib_impl(n - 1) + fib_impl(n - 2);
     });
     
     cout << "记忆化斐波那契:" << endl;
-    cout << "memo_fib(10) = " << memo_fib(10) << endl;
-    cout << "memo_fib(10) = " << memo_fib(10) << endl;  // 从缓存获取
+    cout << "memo_fib(80) = " << memo_fib(80) << ", 缓存项数: " << memo_fib.cache_size() << endl;
+    cout << "memo_fib(80) = " << memo_fib(80) << " (从缓存获取)" << endl;
+    
+    // 每次 memoize 得到独立的缓存
+    auto memo_square = memoize<int, int>([](int n) { return n * n; });
+    memo_square(3);
+    cout << "独立实例的缓存项数: " << memo_square.cache_size() << endl;
+}
+
+// 组合/柯里化得到的函数对象与手写循环对比；std::function 包装同一组合作为对照
+void benchmark_combinators() {
+    cout << "\n=== 组合器性能对比 ===" << endl;
+    
+    const int N = 10000000;
+    vector<int> data(N);
+    for (int i = 0; i < N; ++i) data[i] = i % 1000;
+    
+    auto measure = [](const string& desc, auto func) {
+        auto start = chrono::high_resolution_clock::now();
+        long long result = func();
+        auto end = chrono::high_resolution_clock::now();
+        cout << "  " << desc << ": " << chrono::duration_cast<chrono::microseconds>(end - start).count()
+             << " μs (结果 " << result << ")" << endl;
+    };
+    
+    auto square = [](int x) { return x * x; };
+    auto add_one = [](int x) { return x + 1; };
+    auto triple = [](int x) { return 3 * x; };
+    auto pipeline = compose(triple, add_one, square);
+    auto add3 = [](int a, int b, int c) { return a + b + c; };
+    auto add_5_3 = curry(add3)(5)(3);
+    
+    measure("手写 3 * (x * x + 1)", [&] {
+        long long sum = 0;
+        for (int x : data) sum += 3 * (x * x + 1);
+        return sum;
+    });
+    measure("compose(triple, add_one, square)", [&] {
+        long long sum = 0;
+        for (int x : data) sum += pipeline(x);
+        return sum;
+    });
+    function<int(int)> erased = pipeline;
+    measure("std::function 包装同一组合", [&] {
+        long long sum = 0;
+        for (int x : data) sum += erased(x);
+        return sum;
+    });
+    measure("手写 x + 5 + 3", [&] {
+        long long sum = 0;
+        for (int x : data) sum += 5 + 3 + x;
+        return sum;
+    });
+    measure("curry(add3)(5)(3)", [&] {
+        long long sum = 0;
+        for (int x : data) sum += add_5_3(x);
+        return sum;
+    });
 }
 
 // 5. 异步函数和future
@@ -421,9 +877,10 @@ void perfect_forwarding() {
 }
 
 // 10. 实际应用：事件系统
+// 对照组：按字符串查 std::map，每个处理器是一个 std::function
 class EventManager {
 private:
-    map<string, vector<function<void(const string&)>>> handlers;
+    std::map<string, vector<function<void(const string&)>>> handlers;
     
 public:
     void subscribe(const string& event, function<void(const string&)> handler) {
@@ -431,50 +888,321 @@ public:
     }
     
     void publish(const string& event, const string& data) {
-        cout << "发布事件: " << event << " 数据: " << data << endl;
         if (handlers.find(event) != handlers.end()) {
             for (auto& handler : handlers[event]) {
                 handler(data);
             }
         }
     }
-    
-    template<typename... Args>
-    void subscribe_multiple(const string& event, Args... handlers) {
-        (subscribe(event, handlers), ...);
+};
+
+// 事件总线：事件名在订阅时映射为整数 ID，发布时按 ID 直接索引。
+// 所有处理器按事件顺序存放在一个连续数组中，offsets[id] .. offsets[id+1] 是事件 id 的处理器；
+// 订阅较少、发布频繁，订阅时移动数组元素，发布时只顺序扫描。
+using EventId = uint32_t;
+// 处理器存放在 inplace_function 的内联缓冲区中，订阅与发布都不分配堆内存
+using EventHandler = inplace_function<void(std::string_view)>;
+
+class EventBus {
+private:
+    std::unordered_map<string, EventId> ids;
+    vector<string> names;
+    vector<EventHandler> handlers;
+    vector<uint32_t> offsets{0};
+
+public:
+    EventId intern(std::string_view name) {
+        auto [it, inserted] = ids.try_emplace(string(name), static_cast<EventId>(names.size()));
+        if (inserted) {
+            names.emplace_back(name);
+            offsets.push_back(offsets.back());
+        }
+        return it->second;
+    }
+
+    const string& name(EventId id) const { return names[id]; }
+
+    template<typename F>
+    EventId subscribe(std::string_view event, F&& handler) {
+        EventId id = intern(event);
+        handlers.emplace(handlers.begin() + offsets[id + 1], forward<F>(handler));
+        for (size_t i = id + 1; i < offsets.size(); ++i) {
+            ++offsets[i];
+        }
+        return id;
+    }
+
+    template<typename... Fs>
+    EventId subscribe_multiple(std::string_view event, Fs&&... fs) {
+        EventId id = intern(event);
+        (subscribe(event, forward<Fs>(fs)), ...);
+        return id;
+    }
+
+    void publish(EventId id, std::string_view data) const {
+        const EventHandler* h = handlers.data() + offsets[id];
+        const EventHandler* end = handlers.data() + offsets[id + 1];
+        for (; h != end; ++h) {
+            (*h)(data);
+        }
+    }
+
+    // 批量发布：外层按处理器、内层按数据，每个处理器的代码与状态连续命中缓存
+    void publish_batch(EventId id, const std::string_view* data, size_t count) const {
+        const EventHandler* h = handlers.data() + offsets[id];
+        const EventHandler* end = handlers.data() + offsets[id + 1];
+        for (; h != end; ++h) {
+            for (size_t i = 0; i < count; ++i) {
+                (*h)(data[i]);
+            }
+        }
+    }
+
+    size_t handler_count(EventId id) const { return offsets[id + 1] - offsets[id]; }
+};
+
+// 异步事件总线：每个订阅者有自己的队列，保证同一订阅者按发布顺序处理；
+// 有待处理消息的订阅者进入就绪队列，由线程池中的某一个工作线程整批取走执行。
+// 每次发布只复制一次数据，由各订阅者队列共享。订阅需在开始发布前完成。
+class AsyncEventBus {
+private:
+    using Message = shared_ptr<const string>;
+
+    struct Subscriber {
+        EventHandler handler;
+        std::mutex mtx;
+        std::deque<Message> queue;
+        bool scheduled = false;   // 已在就绪队列中或正在被执行
+
+        explicit Subscriber(EventHandler h) : handler(std::move(h)) {}
+    };
+
+    std::unordered_map<string, EventId> ids;
+    vector<vector<uint32_t>> subscribers_of;   // 事件 ID -> 订阅者下标
+    vector<std::unique_ptr<Subscriber>> subscribers;
+
+    std::mutex ready_mtx;
+    std::condition_variable ready_cv;
+    std::condition_variable idle_cv;
+    std::deque<uint32_t> ready;
+    size_t pending = 0;          // 尚未处理完的消息数
+    bool stopping = false;
+    vector<thread> workers;
+
+    void schedule(uint32_t index) {
+        {
+            std::lock_guard<std::mutex> lock(ready_mtx);
+            ready.push_back(index);
+        }
+        ready_cv.notify_one();
+    }
+
+    void worker_loop() {
+        std::deque<Message> batch;
+        while (true) {
+            uint32_t index;
+            {
+                std::unique_lock<std::mutex> lock(ready_mtx);
+                ready_cv.wait(lock, [this] { return stopping || !ready.empty(); });
+                if (ready.empty()) return;
+                index = ready.front();
+                ready.pop_front();
+            }
+
+            Subscriber& sub = *subscribers[index];
+            {
+                std::lock_guard<std::mutex> lock(sub.mtx);
+                batch.swap(sub.queue);
+            }
+            for (const Message& msg : batch) {
+                sub.handler(*msg);
+            }
+            size_t done = batch.size();
+            batch.clear();
+
+            bool more;
+            {
+                std::lock_guard<std::mutex> lock(sub.mtx);
+                more = !sub.queue.empty();
+                sub.scheduled = more;
+            }
+            if (more) schedule(index);
+
+            std::lock_guard<std::mutex> lock(ready_mtx);
+            pending -= done;
+            if (pending == 0) idle_cv.notify_all();
+        }
+    }
+
+public:
+    explicit AsyncEventBus(unsigned threads) {
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~AsyncEventBus() {
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(ready_mtx);
+            stopping = true;
+        }
+        ready_cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    EventId intern(std::string_view name) {
+        auto [it, inserted] = ids.try_emplace(string(name), static_cast<EventId>(subscribers_of.size()));
+        if (inserted) subscribers_of.emplace_back();
+        return it->second;
+    }
+
+    template<typename F>
+    EventId subscribe(std::string_view event, F&& handler) {
+        EventId id = intern(event);
+        subscribers_of[id].push_back(static_cast<uint32_t>(subscribers.size()));
+        subscribers.push_back(std::make_unique<Subscriber>(EventHandler(forward<F>(handler))));
+        return id;
+    }
+
+    void publish(EventId id, std::string_view data) {
+        const auto& targets = subscribers_of[id];
+        if (targets.empty()) return;
+        auto msg = make_shared<const string>(data);
+        {
+            std::lock_guard<std::mutex> lock(ready_mtx);
+            pending += targets.size();
+        }
+        for (uint32_t index : targets) {
+            Subscriber& sub = *subscribers[index];
+            bool need_schedule;
+            {
+                std::lock_guard<std::mutex> lock(sub.mtx);
+                sub.queue.push_back(msg);
+                need_schedule = !sub.scheduled;
+                sub.scheduled = true;
+            }
+            if (need_schedule) schedule(index);
+        }
+    }
+
+    // 等待所有已发布的消息处理完毕
+    void drain() {
+        std::unique_lock<std::mutex> lock(ready_mtx);
+        idle_cv.wait(lock, [this] { return pending == 0; });
     }
 };
 
 void practical_event_system() {
     cout << "\n=== 实际应用：事件系统 ===" << endl;
     
-    EventManager em;
+    EventBus bus;
     
-    // 订阅事件
-    em.subscribe("user_login", [](const string& data) {
+    // 订阅事件：名称在此时转换为 ID
+    EventId login = bus.subscribe("user_login", [](std::string_view data) {
         cout << "  日志处理器: 用户登录 - " << data << endl;
     });
     
-    em.subscribe("user_login", [](const string& data) {
+    bus.subscribe("user_login", [](std::string_view data) {
         cout << "  统计处理器: 记录登录统计 - " << data << endl;
     });
     
-    em.subscribe("user_login", [](const string& data) {
+    bus.subscribe("user_login", [](std::string_view data) {
         cout << "  安全处理器: 检查登录安全 - " << data << endl;
     });
     
     // 一次订阅多个处理器
-    em.subscribe_multiple("user_logout",
-        [](const string& data) { cout << "  清理会话: " << data << endl; },
-        [](const string& data) { cout << "  更新状态: " << data << endl; }
+    EventId logout = bus.subscribe_multiple("user_logout",
+        [](std::string_view data) { cout << "  清理会话: " << data << endl; },
+        [](std::string_view data) { cout << "  更新状态: " << data << endl; }
     );
     
-    // 发布事件
-    em.publish("user_login", "user123");
-    em.publish("user_logout", "user123");
+    // 发布事件：按 ID 直接索引，数据以 string_view 传递，不复制
+    cout << "发布事件: " << bus.name(login) << " 数据: user123" << endl;
+    bus.publish(login, "user123");
+    cout << "发布事件: " << bus.name(logout) << " 数据: user123" << endl;
+    bus.publish(logout, "user123");
+    
+    // 批量发布
+    std::string_view users[] = {"alice", "bob"};
+    cout << "批量发布 " << bus.name(logout) << ":" << endl;
+    bus.publish_batch(logout, users, 2);
+    
+    // 异步模式：每个订阅者按发布顺序处理自己的消息
+    std::atomic<int> async_handled{0};
+    {
+        AsyncEventBus async_bus(2);
+        EventId tick = async_bus.subscribe("tick", [&](std::string_view) { ++async_handled; });
+        async_bus.subscribe("tick", [&](std::string_view) { ++async_handled; });
+        for (int i = 0; i < 1000; ++i) {
+            async_bus.publish(tick, "t");
+        }
+        async_bus.drain();
+    }
+    cout << "异步总线处理消息数: " << async_handled << " (期望 2000)" << endl;
+}
+
+// 每秒发布次数对比：3 个处理器，各自累加数据长度
+void benchmark_event_system() {
+    cout << "\n=== 事件系统性能对比 ===" << endl;
+    
+    const int N = 2000000;
+    const string payload = "user123";
+    size_t total = 0;
+    
+    auto report = [](const string& desc, auto func) {
+        auto start = chrono::high_resolution_clock::now();
+        func();
+        auto end = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(end - start).count();
+        cout << "  " << desc << ": " << static_cast<long long>(N / seconds) << " 次发布/秒" << endl;
+    };
+    
+    EventManager manager;
+    EventBus bus;
+    EventId id = 0;
+    for (int i = 0; i < 3; ++i) {
+        manager.subscribe("user_login", [&total](const string& d) { total += d.size(); });
+        id = bus.subscribe("user_login", [&total](std::string_view d) { total += d.size(); });
+    }
+    // 其他事件，使 map 查找不至于过于简单
+    for (int i = 0; i < 32; ++i) {
+        manager.subscribe("event_" + to_string(i), [](const string&) {});
+        bus.subscribe("event_" + to_string(i), [](std::string_view) {});
+    }
+    
+    report("std::map + std::function", [&] {
+        for (int i = 0; i < N; ++i) manager.publish("user_login", payload);
+    });
+    report("EventBus 按 ID 发布", [&] {
+        for (int i = 0; i < N; ++i) bus.publish(id, payload);
+    });
+    vector<std::string_view> batch(256, payload);
+    report("EventBus 批量发布 (256/批)", [&] {
+        for (int i = 0; i < N; i += 256) bus.publish_batch(id, batch.data(), std::min<size_t>(256, N - i));
+    });
+    
+    std::atomic<size_t> async_total{0};
+    {
+        unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+        AsyncEventBus async_bus(threads);
+        EventId async_id = 0;
+        for (int i = 0; i < 3; ++i) {
+            async_id = async_bus.subscribe("user_login", [&async_total](std::string_view d) {
+                async_total.fetch_add(d.size(), std::memory_order_relaxed);
+            });
+        }
+        report("AsyncEventBus (" + to_string(threads) + " 工作线程, 含等待处理完毕)", [&] {
+            for (int i = 0; i < N; ++i) async_bus.publish(async_id, payload);
+            async_bus.drain();
+        });
+    }
+    
+    size_t expected = size_t(N) * 3 * payload.size();
+    cout << "  校验: " << (total == 3 * expected && async_total == expected ? "通过" : "失败") << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     print_separator("高级函数特性详解");
     
     // 1. Lambda表达式
@@ -485,9 +1213,12 @@ int main() {
     
     // 3. 函数式编程
     functional_programming_examples();
+    // 传入元素个数（如 100000000）可测试更大规模，逐级版本约需 1 GB 内存
+    benchmark_pipeline(argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000);
     
     // 4. 高阶函数
     higher_order_functions();
+    benchmark_combinators();
     
     // 5. 异步函数
     async_functions();
@@ -506,6 +1237,7 @@ int main() {
     
     // 10. 实际应用
     practical_event_system();
+    benchmark_event_system();
     
     // 总结：高级函数特性的优势
     cout << "\n=== 高级函数特性总结 ===" << endl;
@@ -1,5 +1,16 @@
 #include "common.h"
 #include <functional>
+#include <cstdint>
+#include "expression.h"
+
+using std::map;
+using std::function;
+using std::swap;
+using std::bind;
+using std::thread;
+namespace placeholders = std::placeholders;
+namespace this_thread = std::this_thread;
+namespace chrono = std::chrono;
 
 // 1. 基本函数定义
 int add(int a, int b) {
@@ -155,32 +166,119 @@ void progress_printer(int current, int total) {
 }
 
 // 9. 事件处理系统
+// EventType 是连续的小枚举，COUNT 给出种类数，处理器表直接按枚举值索引
 enum class EventType {
     CLICK,
     KEY_PRESS,
-    MOUSE_MOVE
+    MOUSE_MOVE,
+    COUNT
 };
 
+constexpr size_t kEventTypeCount = static_cast<size_t>(EventType::COUNT);
+
+const char* event_name(EventType type) {
+    static const char* names[kEventTypeCount] = {"CLICK", "KEY_PRESS", "MOUSE_MOVE"};
+    size_t index = static_cast<size_t>(type);
+    return index < kEventTypeCount ? names[index] : "UNKNOWN";
+}
+
 typedef void (*EventHandler)(EventType type, int data);
 
+// 处理器表：每种事件一个不可变快照，触发时无锁读取。
+// 注册在互斥锁下复制旧快照、追加处理器、原子地发布新快照；
+// 旧快照可能仍被正在触发的线程读取，保留到 EventSystem 析构时再释放（注册是低频操作）。
 class EventSystem {
 private:
-    map<EventType, vector<EventHandler>> handlers;
-    
+    struct Snapshot {
+        vector<EventHandler> handlers;
+    };
+
+    std::array<std::atomic<const Snapshot*>, kEventTypeCount> tables{};
+    std::mutex register_mutex;
+    vector<std::unique_ptr<const Snapshot>> snapshots;   // 所有发布过的快照
+
+    // 合并队列：可合并的事件在队列中只保留一项，后到的数据覆盖前者
+    vector<std::pair<EventType, int>> queue;
+    std::array<bool, kEventTypeCount> coalesce{};
+    std::array<size_t, kEventTypeCount> pending_slot;
+    size_t coalesced = 0;
+
+    static constexpr size_t kNoSlot = SIZE_MAX;
+
+public:
+    EventSystem() {
+        pending_slot.fill(kNoSlot);
+    }
+
+    EventSystem(const EventSystem&) = delete;
+    EventSystem& operator=(const EventSystem&) = delete;
+
+    void register_handler(EventType type, EventHandler handler) {
+        size_t index = static_cast<size_t>(type);
+        std::lock_guard<std::mutex> lock(register_mutex);
+        auto next = std::make_unique<Snapshot>();
+        if (const Snapshot* current = tables[index].load(std::memory_order_relaxed)) {
+            next->handlers = current->handlers;
+        }
+        next->handlers.push_back(handler);
+        tables[index].store(next.get(), std::memory_order_release);
+        snapshots.push_back(std::move(next));
+    }
+
+    // 可在多个线程中与 register_handler 并发调用
+    void trigger_event(EventType type, int data) const {
+        const Snapshot* snapshot = tables[static_cast<size_t>(type)].load(std::memory_order_acquire);
+        if (!snapshot) {
+            return;
+        }
+        for (EventHandler handler : snapshot->handlers) {
+            handler(type, data);
+        }
+    }
+
+    // 以下投递/分发接口由单个事件循环线程使用
+    void set_coalescing(EventType type, bool enabled) {
+        coalesce[static_cast<size_t>(type)] = enabled;
+    }
+
+    void post_event(EventType type, int data) {
+        size_t index = static_cast<size_t>(type);
+        if (coalesce[index]) {
+            if (pending_slot[index] != kNoSlot) {
+                queue[pending_slot[index]].second = data;
+                ++coalesced;
+                return;
+            }
+            pending_slot[index] = queue.size();
+        }
+        queue.emplace_back(type, data);
+    }
+
+    // 按投递顺序分发队列中的事件，合并后的事件位于其第一次出现的位置
+    size_t dispatch_pending() {
+        for (const auto& [type, data] : queue) {
+            trigger_event(type, data);
+        }
+        size_t dispatched = queue.size();
+        queue.clear();
+        pending_slot.fill(kNoSlot);
+        return dispatched;
+    }
+
+    size_t coalesced_count() const { return coalesced; }
+};
+
+// 对照组：每次触发都查一次 std::map
+class MapEventSystem {
+private:
+    std::map<EventType, vector<EventHandler>> handlers;
+
 public:
     void register_handler(EventType type, EventHandler handler) {
         handlers[type].push_back(handler);
     }
-    
+
     void trigger_event(EventType type, int data) {
-        cout << "触发事件: ";
-        switch (type) {
-            case EventType::CLICK: cout << "CLICK"; break;
-            case EventType::KEY_PRESS: cout << "KEY_PRESS"; break;
-            case EventType::MOUSE_MOVE: cout << "MOUSE_MOVE"; break;
-        }
-        cout << " (数据: " << data << ")" << endl;
-        
         if (handlers.find(type) != handlers.end()) {
             for (auto handler : handlers[type]) {
                 handler(type, data);
@@ -201,6 +299,84 @@ void mouse_handler(EventType type, int data) {
     cout << "  鼠标处理器: 移动到位置 " << data << endl;
 }
 
+// 性能测试用的计数处理器
+std::array<std::atomic<long long>, kEventTypeCount> g_event_sums{};
+
+void counting_handler(EventType type, int data) {
+    g_event_sums[static_cast<size_t>(type)].fetch_add(data, std::memory_order_relaxed);
+}
+
+// 合成事件流：80% MOUSE_MOVE，其余为 CLICK 与 KEY_PRESS
+void benchmark_event_dispatch() {
+    cout << "\n=== 事件分发性能对比 ===" << endl;
+
+    const int N = 10000000;
+    vector<std::pair<EventType, int>> stream(N);
+    std::mt19937 gen(11);
+    for (auto& e : stream) {
+        unsigned r = gen() % 10;
+        e.first = r < 8 ? EventType::MOUSE_MOVE : (r == 8 ? EventType::CLICK : EventType::KEY_PRESS);
+        e.second = static_cast<int>(gen() % 1920);
+    }
+
+    auto report = [N](const string& desc, auto func) {
+        for (auto& sum : g_event_sums) sum = 0;
+        auto start = chrono::high_resolution_clock::now();
+        func();
+        auto end = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(end - start).count();
+        cout << "  " << desc << ": " << static_cast<long long>(N / seconds) << " 事件/秒" << endl;
+    };
+
+    MapEventSystem map_system;
+    EventSystem table_system;
+    for (size_t t = 0; t < kEventTypeCount; ++t) {
+        map_system.register_handler(static_cast<EventType>(t), counting_handler);
+        table_system.register_handler(static_cast<EventType>(t), counting_handler);
+    }
+
+    report("std::map 查找", [&] {
+        for (const auto& [type, data] : stream) map_system.trigger_event(type, data);
+    });
+    long long map_clicks = g_event_sums[static_cast<size_t>(EventType::CLICK)];
+
+    report("枚举索引表", [&] {
+        for (const auto& [type, data] : stream) table_system.trigger_event(type, data);
+    });
+    bool same = map_clicks == g_event_sums[static_cast<size_t>(EventType::CLICK)];
+
+    // 每 1000 个事件为一帧，帧内 MOUSE_MOVE 只分发最后一次
+    size_t dispatched = 0;
+    table_system.set_coalescing(EventType::MOUSE_MOVE, true);
+    report("枚举索引表 + MOUSE_MOVE 合并 (1000 事件/帧)", [&] {
+        for (int i = 0; i < N; ++i) {
+            table_system.post_event(stream[i].first, stream[i].second);
+            if (i % 1000 == 999) dispatched += table_system.dispatch_pending();
+        }
+        dispatched += table_system.dispatch_pending();
+    });
+    cout << "    实际分发 " << dispatched << " 个事件, 合并 " << table_system.coalesced_count() << " 个" << endl;
+    cout << "    两种分发方式结果一致: " << (same ? "是" : "否") << endl;
+
+    // 多个线程触发的同时注册新处理器：触发方始终看到完整的快照
+    for (auto& sum : g_event_sums) sum = 0;
+    EventSystem concurrent_system;
+    concurrent_system.register_handler(EventType::CLICK, counting_handler);
+    vector<thread> triggers;
+    for (int t = 0; t < 2; ++t) {
+        triggers.emplace_back([&concurrent_system] {
+            for (int i = 0; i < 200000; ++i) concurrent_system.trigger_event(EventType::CLICK, 1);
+        });
+    }
+    for (int i = 0; i < 3; ++i) {
+        concurrent_system.register_handler(EventType::CLICK, counting_handler);
+    }
+    for (auto& t : triggers) t.join();
+    long long clicks = g_event_sums[static_cast<size_t>(EventType::CLICK)];
+    cout << "  并发触发 + 注册: 处理器调用 " << clicks << " 次 (介于 400000 与 1600000 之间: "
+         << (clicks >= 400000 && clicks <= 1600000 ? "是" : "否") << ")" << endl;
+}
+
 // 10. 函数指针数组和查找表
 enum class Operation {
     ADD = 0,
@@ -209,21 +385,37 @@ enum class Operation {
     DIVIDE = 3
 };
 
+// 批量版本：Op 是模板参数，循环内直接内联，可以向量化
+template<int (*Op)(int, int)>
+void apply_batch(const int* a, const int* b, int* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = Op(a[i], b[i]);
+    }
+}
+
 class OperationTable {
 private:
     static int (*operations[])(int, int);
+    static void (*batch_operations[])(const int*, const int*, int*, size_t);
     static const char* names[];
     
 public:
     static int execute(Operation op, int a, int b) {
         int index = static_cast<int>(op);
         if (index >= 0 && index < 4) {
-            cout << "  执行操作 " << names[index] << "(" << a << ", " << b << ") = ";
             return operations[index](a, b);
         }
         return 0;
     }
     
+    // 每批只查表一次，而不是每个元素一次
+    static void execute_batch(Operation op, const int* a, const int* b, int* out, size_t n) {
+        int index = static_cast<int>(op);
+        if (index >= 0 && index < 4) {
+            batch_operations[index](a, b, out, n);
+        }
+    }
+    
     static const char* get_name(Operation op) {
         int index = static_cast<int>(op);
         if (index >= 0 && index < 4) {
@@ -235,8 +427,66 @@ public:
 
 // 静态成员定义
 int (*OperationTable::operations[])(int, int) = {add, subtract, multiply, divide};
+void (*OperationTable::batch_operations[])(const int*, const int*, int*, size_t) = {
+    apply_batch<add>, apply_batch<subtract>, apply_batch<multiply>, apply_batch<divide>};
 const char* OperationTable::names[] = {"加法", "减法", "乘法", "除法"};
 
+// 表达式求值：解析一次成字节码，再按列批量求值（见 common/expression.h）
+void benchmark_expression(size_t rows) {
+    cout << "\n=== 表达式批量求值性能对比 (" << rows << " 行) ===" << endl;
+    
+    const string formula = "price * quantity * (1 - discount) + shipping";
+    Expression expr(formula, {"price", "quantity", "discount", "shipping"});
+    
+    vector<double> price(rows), quantity(rows), discount(rows), shipping(rows), out(rows);
+    std::mt19937 gen(5);
+    for (size_t i = 0; i < rows; ++i) {
+        price[i] = 1 + gen() % 10000 / 100.0;
+        quantity[i] = 1 + gen() % 20;
+        discount[i] = gen() % 30 / 100.0;
+        shipping[i] = gen() % 500 / 100.0;
+    }
+    vector<const double*> columns = {price.data(), quantity.data(), discount.data(), shipping.data()};
+    
+    // 4 列输入 + 1 列输出
+    auto report = [](const string& desc, size_t processed, auto func) {
+        auto start = chrono::high_resolution_clock::now();
+        func();
+        auto end = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(end - start).count();
+        cout << "  " << desc << ": " << static_cast<long long>(processed / seconds) << " 行/秒, "
+             << std::fixed << std::setprecision(2) << processed * 5 * sizeof(double) / seconds / 1e9
+             << " GB/s" << std::defaultfloat << endl;
+    };
+    
+    double checksum = 0;
+    size_t sample = std::min<size_t>(rows, 1000000);
+    // 逐行标量解释：每行把每条指令分派一次，不分配内存
+    report("逐行解释 (前 " + to_string(sample) + " 行)", sample, [&] {
+        for (size_t i = 0; i < sample; ++i) {
+            const double row[] = {price[i], quantity[i], discount[i], shipping[i]};
+            out[i] = expr.evaluate_row(row);
+        }
+    });
+    report("手写循环", rows, [&] {
+        for (size_t i = 0; i < rows; ++i) {
+            out[i] = price[i] * quantity[i] * (1 - discount[i]) + shipping[i];
+        }
+    });
+    for (size_t i = 0; i < rows; i += 997) checksum += out[i];
+    
+    report("字节码批量求值", rows, [&] { expr.evaluate(columns, out.data(), rows); });
+    double batch_checksum = 0;
+    for (size_t i = 0; i < rows; i += 997) batch_checksum += out[i];
+    
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    report("字节码批量求值 (" + to_string(threads) + " 线程)", rows, [&] {
+        expr.evaluate(columns, out.data(), rows, threads);
+    });
+    
+    cout << "  结果一致: " << (checksum == batch_checksum ? "是" : "否") << endl;
+}
+
 // 11. 排序算法与比较函数
 void bubble_sort(int arr[], int size, bool (*compare)(int, int)) {
     for (int i = 0; i < size - 1; i++) {
@@ -324,9 +574,12 @@ void demonstrate_std_function() {
     cout << "std::function + bind: " << op5(5, 3) << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     print_separator("函数指针详解");
     
+    // 表达式基准的行数，可传入 100000000 测试更大规模（约需 4 GB 内存）
+    size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    
     // 1. 基本函数指针使用
     cout << "=== 基本函数指针使用 ===" << endl;
     
@@ -449,9 +702,25 @@ int main() {
     event_system.register_handler(EventType::MOUSE_MOVE, mouse_handler);
     
     // 触发事件
-    event_system.trigger_event(EventType::CLICK, 1);
-    event_system.trigger_event(EventType::KEY_PRESS, 65);  // 'A'
-    event_system.trigger_event(EventType::MOUSE_MOVE, 100);
+    std::pair<EventType, int> events[] = {
+        {EventType::CLICK, 1}, {EventType::KEY_PRESS, 65}, {EventType::MOUSE_MOVE, 100}  // 65: 'A'
+    };
+    for (const auto& [type, data] : events) {
+        cout << "触发事件: " << event_name(type) << " (数据: " << data << ")" << endl;
+        event_system.trigger_event(type, data);
+    }
+    
+    // 合并高频事件：一帧内的多次 MOUSE_MOVE 只分发最后的位置
+    event_system.set_coalescing(EventType::MOUSE_MOVE, true);
+    event_system.post_event(EventType::MOUSE_MOVE, 101);
+    event_system.post_event(EventType::CLICK, 2);
+    event_system.post_event(EventType::MOUSE_MOVE, 102);
+    event_system.post_event(EventType::MOUSE_MOVE, 103);
+    cout << "投递 4 个事件后分发:" << endl;
+    event_system.dispatch_pending();
+    cout << "合并的事件数: " << event_system.coalesced_count() << endl;
+    
+    benchmark_event_dispatch();
     
     // 9. 操作查找表
     cout << "\n=== 操作查找表 ===" << endl;
@@ -460,9 +729,24 @@ int main() {
     
     for (auto op : ops_enum) {
         int result = OperationTable::execute(op, 15, 3);
-        cout << result << endl;
+        cout << "  执行操作 " << OperationTable::get_name(op) << "(15, 3) = " << result << endl;
     }
     
+    int lhs[] = {15, 20, 25, 30}, rhs[] = {3, 4, 5, 6}, products[4];
+    OperationTable::execute_batch(Operation::MULTIPLY, lhs, rhs, products, 4);
+    cout << "  批量乘法: ";
+    for (int p : products) cout << p << " ";
+    cout << endl;
+    
+    // 表达式解析一次，编译成字节码后可反复求值
+    Expression formula("price * quantity * (1 - discount) + shipping",
+                       {"price", "quantity", "discount", "shipping"});
+    cout << "表达式字节码 (" << formula.instruction_count() << " 条指令):" << endl;
+    cout << formula.disassemble();
+    cout << "price=10, quantity=3, discount=0.1, shipping=5 => " << formula.evaluate({10, 3, 0.1, 5}) << endl;
+    
+    benchmark_expression(rows);
+    
     // 10. 排序算法与比较函数
     cout << "\n=== 排序算法与比较函数 ===" << endl;
     
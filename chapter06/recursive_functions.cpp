@@ -1,4 +1,13 @@
 #include "common.h"
+#include "memoize.h"
+
+using std::map;
+using std::function;
+using std::tuple;
+using std::make_tuple;
+using std::swap;
+using std::max;
+namespace chrono = std::chrono;
 
 // 1. 基础递归示例
 
@@ -228,6 +237,7 @@ long long combination(int n, int k) {
 }
 
 // 9. 二叉树递归操作
+// 递归深度等于树高，退化树会栈溢出；显式栈与数组布局的版本见 tree_algorithms.cpp
 struct TreeNode {
     int data;
     TreeNode* left;
@@ -293,73 +303,199 @@ bool search_tree(TreeNode* root, int target) {
 }
 
 // 10. 排序算法递归实现
+// 归并排序与快速排序保留分治的递归结构，但去掉逐层打印与逐层分配：
+// 小区间改用插入排序，大区间在 fork-join 中把一半交给新线程。
+const ptrdiff_t kInsertionSortCutoff = 24;
+const ptrdiff_t kParallelSortCutoff = 1 << 16;
+
+void insertion_sort(int* first, int* last) {
+    for (int* i = first + 1; i < last; ++i) {
+        int value = *i;
+        int* j = i;
+        for (; j > first && value < j[-1]; --j) {
+            *j = j[-1];
+        }
+        *j = value;
+    }
+}
+
+// 允许并行的递归层数：每层线程数翻倍，够用即可
+int parallel_sort_depth() {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    int depth = 0;
+    while ((1u << depth) < threads) ++depth;
+    return depth;
+}
 
 // 归并排序
-void merge(vector<int>& arr, int left, int mid, int right) {
-    vector<int> temp(right - left + 1);
-    int i = left, j = mid + 1, k = 0;
-    
-    while (i <= mid && j <= right) {
-        if (arr[i] <= arr[j]) {
-            temp[k++] = arr[i++];
-        } else {
-            temp[k++] = arr[j++];
-        }
+// 整个排序只分配一个缓冲区：合并时只把左半部分拷入缓冲区，再与右半部分合并回原数组；
+// 两半已经有序（左半最大值 <= 右半最小值）时直接跳过合并。
+void merge(int* first, int* mid, int* last, int* buffer) {
+    if (!(*mid < mid[-1])) {
+        return;
     }
-    
-    while (i <= mid) {
-        temp[k++] = arr[i++];
+    int* buffer_end = std::copy(first, mid, buffer);
+    int* out = first;
+    int* i = buffer;
+    int* j = mid;
+    while (i < buffer_end && j < last) {
+        *out++ = (*j < *i) ? *j++ : *i++;   // 相等时取左侧，保持稳定
     }
-    
-    while (j <= right) {
-        temp[k++] = arr[j++];
+    std::copy(i, buffer_end, out);
+}
+
+void merge_sort_impl(int* first, int* last, int* buffer, int spawn_depth) {
+    ptrdiff_t n = last - first;
+    if (n <= kInsertionSortCutoff) {
+        insertion_sort(first, last);
+        return;
     }
-    
-    for (int i = 0; i < k; i++) {
-        arr[left + i] = temp[i];
+    int* mid = first + n / 2;
+    if (spawn_depth > 0 && n >= kParallelSortCutoff) {
+        std::thread left([=] { merge_sort_impl(first, mid, buffer, spawn_depth - 1); });
+        merge_sort_impl(mid, last, buffer + n / 2, spawn_depth - 1);
+        left.join();
+    } else {
+        merge_sort_impl(first, mid, buffer, 0);
+        merge_sort_impl(mid, last, buffer + n / 2, 0);
     }
+    merge(first, mid, last, buffer);
 }
 
 void merge_sort(vector<int>& arr, int left, int right) {
     if (left >= right) {
         return;
     }
-    
-    int mid = left + (right - left) / 2;
-    
-    cout << "  分割: [" << left << "," << mid << "] 和 [" << (mid+1) << "," << right << "]" << endl;
-    
-    merge_sort(arr, left, mid);
-    merge_sort(arr, mid + 1, right);
-    
-    cout << "  合并: [" << left << "," << right << "]" << endl;
-    merge(arr, left, mid, right);
+    vector<int> buffer(right - left + 1);   // 左右两半各用对应的一段，并行时互不重叠
+    merge_sort_impl(arr.data() + left, arr.data() + right + 1, buffer.data(), parallel_sort_depth());
 }
 
-// 快速排序
-int partition(vector<int>& arr, int low, int high) {
-    int pivot = arr[high];
-    int i = low - 1;
-    
-    for (int j = low; j < high; j++) {
-        if (arr[j] < pivot) {
-            i++;
-            swap(arr[i], arr[j]);
+// 快速排序（introsort）
+// 枢轴取三数中值，大区间取 Tukey 九数中值（三组三数中值的中值），有序、逆序输入都不会退化；
+// 分区时与枢轴相等的元素两侧都停，全相等输入也能均分；
+// 递归层数超过 2·log2(n) 时改用堆排序，保证最坏 O(n log n)。
+void sort3(int* a, int* b, int* c) {
+    if (*b < *a) swap(*a, *b);
+    if (*c < *b) swap(*b, *c);
+    if (*b < *a) swap(*a, *b);
+}
+
+// 把枢轴放到 *first
+void choose_pivot(int* first, int* last) {
+    ptrdiff_t n = last - first;
+    int* mid = first + n / 2;
+    if (n > 128) {
+        ptrdiff_t s = n / 8;
+        sort3(first, first + s, first + 2 * s);
+        sort3(mid - s, mid, mid + s);
+        sort3(last - 1 - 2 * s, last - 1 - s, last - 1);
+        sort3(first + s, mid, last - 1 - s);
+    } else {
+        sort3(first, mid, last - 1);
+    }
+    swap(*first, *mid);
+}
+
+int* partition(int* first, int* last) {
+    int pivot = *first;
+    int* i = first;
+    int* j = last;
+    while (true) {
+        do { ++i; } while (i < last && *i < pivot);
+        do { --j; } while (pivot < *j);   // *first == pivot 作为哨兵
+        if (i >= j) break;
+        swap(*i, *j);
+    }
+    swap(*first, *j);
+    return j;
+}
+
+void quick_sort_impl(int* first, int* last, int depth_limit, int spawn_depth) {
+    vector<std::thread> children;
+    while (last - first > kInsertionSortCutoff) {
+        if (depth_limit-- == 0) {
+            std::make_heap(first, last);
+            std::sort_heap(first, last);
+            break;
+        }
+        choose_pivot(first, last);
+        int* cut = partition(first, last);
+
+        // 较小的一侧递归（或交给新线程），较大的一侧循环处理，栈深度 O(log n)
+        int* small_first = first;
+        int* small_last = cut;
+        if (cut - first > last - (cut + 1)) {
+            small_first = cut + 1;
+            small_last = last;
+            last = cut;
+        } else {
+            first = cut + 1;
+        }
+        if (spawn_depth > 0 && small_last - small_first >= kParallelSortCutoff) {
+            --spawn_depth;
+            children.emplace_back([=] { quick_sort_impl(small_first, small_last, depth_limit, spawn_depth); });
+        } else {
+            quick_sort_impl(small_first, small_last, depth_limit, 0);
         }
     }
-    
-    swap(arr[i + 1], arr[high]);
-    return i + 1;
+    if (last - first <= kInsertionSortCutoff) {
+        insertion_sort(first, last);
+    }
+    for (auto& child : children) {
+        child.join();
+    }
 }
 
 void quick_sort(vector<int>& arr, int low, int high) {
-    if (low < high) {
-        int pi = partition(arr, low, high);
-        
-        cout << "  分区: 枢轴=" << arr[pi] << ", 位置=" << pi << endl;
-        
-        quick_sort(arr, low, pi - 1);
-        quick_sort(arr, pi + 1, high);
+    if (low >= high) {
+        return;
+    }
+    int depth_limit = 0;
+    for (int n = high - low + 1; n > 1; n >>= 1) {
+        depth_limit += 2;
+    }
+    quick_sort_impl(arr.data() + low, arr.data() + high + 1, depth_limit, parallel_sort_depth());
+}
+
+// 排序引擎与 std::sort 在对抗性输入上的对比
+void benchmark_sorting(int n) {
+    cout << "数据量: " << n << endl;
+
+    std::mt19937 gen(12345);
+    vector<std::pair<string, vector<int>>> inputs;
+    vector<int> data(n);
+
+    for (auto& x : data) x = static_cast<int>(gen());
+    inputs.push_back({"随机", data});
+    std::iota(data.begin(), data.end(), 0);
+    inputs.push_back({"已排序", data});
+    std::reverse(data.begin(), data.end());
+    inputs.push_back({"逆序", data});
+    std::fill(data.begin(), data.end(), 7);
+    inputs.push_back({"全部相等", data});
+    for (int i = 0; i < n; ++i) data[i] = i < n / 2 ? i : n - i;
+    inputs.push_back({"管风琴（先升后降）", data});
+    for (auto& x : data) x = static_cast<int>(gen() % 4);
+    inputs.push_back({"仅 4 种取值", data});
+
+    auto measure = [](vector<int> arr, auto sort_func, const vector<int>& expected) {
+        auto start = chrono::high_resolution_clock::now();
+        sort_func(arr);
+        auto end = chrono::high_resolution_clock::now();
+        if (arr != expected) {
+            cout << "(结果错误) ";
+        }
+        return chrono::duration_cast<chrono::microseconds>(end - start).count();
+    };
+
+    for (const auto& [name, input] : inputs) {
+        vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        auto t_std = measure(input, [](vector<int>& a) { std::sort(a.begin(), a.end()); }, expected);
+        auto t_merge = measure(input, [](vector<int>& a) { merge_sort(a, 0, static_cast<int>(a.size()) - 1); }, expected);
+        auto t_quick = measure(input, [](vector<int>& a) { quick_sort(a, 0, static_cast<int>(a.size()) - 1); }, expected);
+        cout << "  " << name << ": std::sort " << t_std << " μs, 归并 " << t_merge
+             << " μs, 快速 " << t_quick << " μs" << endl;
     }
 }
 
@@ -384,27 +520,7 @@ void draw_sierpinski_triangle(int n) {
 
 // 12. 递归优化技术
 
-// 记忆化装饰器模板
-template<typename Result, typename... Args>
-class Memoizer {
-private:
-    map<tuple<Args...>, Result> cache;
-    function<Result(Args...)> func;
-    
-public:
-    Memoizer(function<Result(Args...)> f) : func(f) {}
-    
-    Result operator()(Args... args) {
-        auto key = make_tuple(args...);
-        if (cache.find(key) != cache.end()) {
-            return cache[key];
-        }
-        
-        Result result = func(args...);
-        cache[key] = result;
-        return result;
-    }
-};
+// TupleHash、MemoCache（LRU）、Memoizer 与 ConcurrentMemoizer 见 common/memoize.h
 
 // 13. 递归与迭代的对比
 long long factorial_iterative(int n) {
@@ -477,6 +593,57 @@ int main() {
     long long fib10 = fibonacci_memo(10);
     cout << "结果: fib(10) = " << fib10 << endl;
     
+    // 通用记忆化：内部递归经过缓存与绕过缓存的对比
+    Memoizer<long long, int> fib_outer([](int n) {
+        function<long long(int)> fib_impl = [&fib_impl](int k) -> long long {
+            return k <= 1 ? k : fib_impl(k - 1) + fib_impl(k - 2);
+        };
+        return fib_impl(n);
+    });
+    Memoizer<long long, int> fib_self([](auto& self, int n) -> long long {
+        return n <= 1 ? n : self(n - 1) + self(n - 2);
+    });
+    
+    auto memo_start = chrono::high_resolution_clock::now();
+    long long outer_result = fib_outer(32);
+    auto memo_mid = chrono::high_resolution_clock::now();
+    long long self_result = fib_self(32);
+    auto memo_end = chrono::high_resolution_clock::now();
+    cout << "只缓存最外层: fib(32) = " << outer_result << ", "
+         << chrono::duration_cast<chrono::microseconds>(memo_mid - memo_start).count() << " 微秒" << endl;
+    cout << "递归经过缓存: fib(32) = " << self_result << ", "
+         << chrono::duration_cast<chrono::microseconds>(memo_end - memo_mid).count() << " 微秒, 命中 "
+         << fib_self.stats().hits() << " 次, 未命中 " << fib_self.stats().misses() << " 次" << endl;
+    
+    // LRU 上限：组合数 C(n, k) 的缓存最多保留 64 项
+    Memoizer<long long, int, int> binomial([](auto& self, int n, int k) -> long long {
+        if (k == 0 || k == n) return 1;
+        return self(n - 1, k - 1) + self(n - 1, k);
+    }, 64);
+    long long c = 0;
+    for (int n = 20; n <= 30; ++n) {
+        c = binomial(n, n / 2);
+    }
+    cout << "LRU 记忆化: C(30,15) = " << c << ", 缓存项数 " << binomial.stats().size() << " (上限 64)" << endl;
+    
+    // 分片并发记忆化：多个线程共享 Collatz 步数缓存
+    ConcurrentMemoizer<int, long long> collatz([](auto& self, long long x) -> int {
+        if (x == 1) return 0;
+        return 1 + self(x % 2 ? 3 * x + 1 : x / 2);
+    });
+    vector<int> longest(4, 0);
+    vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            for (long long x = 1 + t; x <= 20000; x += 4) {
+                longest[t] = max(longest[t], collatz(x));
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    cout << "并发记忆化: 20000 以内 Collatz 最长步数 " << *std::max_element(longest.begin(), longest.end())
+         << ", 缓存项数 " << collatz.size() << endl;
+    
     // 3. 尾递归优化
     cout << "\n=== 尾递归优化 ===" << endl;
     
@@ -593,7 +760,6 @@ int main() {
     }
     cout << endl;
     
-    cout << "归并排序过程:" << endl;
     merge_sort(merge_arr, 0, merge_arr.size() - 1);
     
     cout << "归并排序后: ";
@@ -609,7 +775,6 @@ int main() {
     }
     cout << endl;
     
-    cout << "快速排序过程:" << endl;
     quick_sort(quick_arr, 0, quick_arr.size() - 1);
     
     cout << "快速排序后: ";
@@ -618,6 +783,9 @@ int main() {
     }
     cout << endl;
     
+    cout << "\n排序引擎性能对比:" << endl;
+    benchmark_sorting(1000000);
+    
     // 10. 分形图案
     cout << "\n=== 分形图案 ===" << endl;
     draw_sierpinski_triangle(3);
@@ -0,0 +1,460 @@
+#include "common.h"
+#include <functional>
+#include <condition_variable>
+#include <queue>
+#include <cstdint>
+
+// 分层时间轮定时调度器
+// long_running_task 用 sleep_for + 回调推进进度，sorting_algorithms 按优先级排序任务；
+// 当定时任务数量达到百万级时，需要 O(1) 的调度/取消以及批量到期处理。
+
+// 1. 分层时间轮
+// 4 层，每层 256 个槽：第 l 层一个槽覆盖 256^l 个 tick。
+// 定时器按到期 tick 与当前 tick 的差值放入对应层，低层转完一圈时把高层的一个槽"降级"下来。
+// 节点放在 vector 中，用下标组成双向链表，调度与取消都是 O(1)。
+class TimerWheel {
+public:
+    using Callback = std::function<void()>;
+
+    struct TimerId {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+    };
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr uint32_t kSlotMask = kSlots - 1;
+    static constexpr uint32_t kOverflowList = kLevels * kSlots;  // 超出 256^4 tick 的定时器
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    struct Node {
+        uint64_t expire = 0;
+        Callback callback;
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t list = kNil;      // 所在链表编号，kNil 表示空闲
+        uint32_t generation = 0;   // 节点复用时递增，使旧的 TimerId 失效
+    };
+
+    vector<Node> nodes;
+    uint32_t free_head = kNil;
+    uint32_t heads[kOverflowList + 1];
+    uint64_t current = 0;
+    size_t active = 0;
+
+    void link(uint32_t list, uint32_t i) {
+        Node& n = nodes[i];
+        n.list = list;
+        n.prev = kNil;
+        n.next = heads[list];
+        if (heads[list] != kNil) nodes[heads[list]].prev = i;
+        heads[list] = i;
+    }
+
+    void unlink(uint32_t i) {
+        Node& n = nodes[i];
+        if (n.prev != kNil) {
+            nodes[n.prev].next = n.next;
+        } else {
+            heads[n.list] = n.next;
+        }
+        if (n.next != kNil) nodes[n.next].prev = n.prev;
+        n.prev = n.next = kNil;
+        n.list = kNil;
+    }
+
+    // 根据到期时间与当前时间的差值选择层和槽
+    void place(uint32_t i) {
+        uint64_t expire = nodes[i].expire;
+        if (expire <= current) {
+            link(current & kSlotMask, i);
+            return;
+        }
+        uint64_t delta = expire - current;
+        for (int level = 0; level < kLevels; ++level) {
+            if (delta < (uint64_t(1) << (kSlotBits * (level + 1)))) {
+                uint32_t slot = (expire >> (kSlotBits * level)) & kSlotMask;
+                link(level * kSlots + slot, i);
+                return;
+            }
+        }
+        link(kOverflowList, i);
+    }
+
+    // 把一个链表中的节点全部按当前时间重新放置
+    void cascade(uint32_t list) {
+        uint32_t i = heads[list];
+        heads[list] = kNil;
+        while (i != kNil) {
+            uint32_t next = nodes[i].next;
+            place(i);
+            i = next;
+        }
+    }
+
+    void release(uint32_t i) {
+        Node& n = nodes[i];
+        n.callback = nullptr;
+        n.list = kNil;
+        ++n.generation;
+        n.next = free_head;
+        free_head = i;
+        --active;
+    }
+
+public:
+    explicit TimerWheel(uint64_t start_tick = 0) : current(start_tick) {
+        std::fill(std::begin(heads), std::end(heads), kNil);
+    }
+
+    uint64_t now() const { return current; }
+    size_t pending() const { return active; }
+
+    void reserve(size_t n) { nodes.reserve(n); }
+
+    // O(1) 调度：delay_ticks 个 tick 后到期
+    TimerId schedule(uint64_t delay_ticks, Callback callback) {
+        uint32_t i;
+        if (free_head != kNil) {
+            i = free_head;
+            free_head = nodes[i].next;
+        } else {
+            i = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& n = nodes[i];
+        n.expire = current + (delay_ticks == 0 ? 1 : delay_ticks);
+        n.callback = std::move(callback);
+        place(i);
+        ++active;
+        return TimerId{i, n.generation};
+    }
+
+    // O(1) 取消；定时器已到期或已取消时返回 false
+    bool cancel(TimerId id) {
+        if (id.index >= nodes.size()) return false;
+        Node& n = nodes[id.index];
+        if (n.generation != id.generation || n.list == kNil) return false;
+        unlink(id.index);
+        release(id.index);
+        return true;
+    }
+
+    // 推进到 target_tick，把所有到期回调追加到 expired（批量处理，不在此执行回调）
+    size_t advance(uint64_t target_tick, vector<Callback>& expired) {
+        size_t fired = 0;
+        while (current < target_tick) {
+            ++current;
+            // 低层转完一圈时逐层降级
+            uint64_t t = current;
+            for (int level = 1; level < kLevels; ++level) {
+                if ((t & kSlotMask) != 0) break;
+                t >>= kSlotBits;
+                cascade(level * kSlots + (t & kSlotMask));
+                if (level == kLevels - 1 && (t & kSlotMask) == 0) cascade(kOverflowList);
+            }
+
+            uint32_t list = current & kSlotMask;
+            uint32_t i = heads[list];
+            heads[list] = kNil;
+            while (i != kNil) {
+                uint32_t next = nodes[i].next;
+                expired.push_back(std::move(nodes[i].callback));
+                release(i);
+                ++fired;
+                i = next;
+            }
+        }
+        return fired;
+    }
+};
+
+// 2. 工作线程池：按批次接收回调
+class WorkerPool {
+private:
+    vector<std::thread> workers;
+    std::queue<vector<TimerWheel::Callback>> batches;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    void run() {
+        for (;;) {
+            vector<TimerWheel::Callback> batch;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [this] { return stopping || !batches.empty(); });
+                if (batches.empty()) return;
+                batch = std::move(batches.front());
+                batches.pop();
+            }
+            for (auto& cb : batch) cb();
+        }
+    }
+
+public:
+    explicit WorkerPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { run(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    void submit(vector<TimerWheel::Callback>&& batch) {
+        if (batch.empty()) return;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            batches.push(std::move(batch));
+        }
+        cv.notify_one();
+    }
+};
+
+// 3. 并发定时服务
+// 任意线程都可以调度/取消；驱动线程按固定 tick 推进时间轮，
+// 每个 tick 的到期回调作为一个批次交给线程池执行，锁内只做 O(1) 的链表操作
+class TimerService {
+private:
+    TimerWheel wheel;
+    std::mutex wheel_mutex;
+    WorkerPool pool;
+    std::chrono::milliseconds tick;
+    std::chrono::steady_clock::time_point start;
+    std::atomic<bool> running{true};
+    std::thread driver;
+
+    void drive() {
+        uint64_t target = 0;
+        vector<TimerWheel::Callback> batch;
+        while (running.load()) {
+            ++target;
+            std::this_thread::sleep_until(start + tick * target);
+            {
+                std::lock_guard<std::mutex> lock(wheel_mutex);
+                // 睡眠可能被推迟，按实际经过的 tick 数追赶
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                target = std::max<uint64_t>(target, static_cast<uint64_t>(elapsed / tick));
+                wheel.advance(target, batch);
+            }
+            pool.submit(std::move(batch));
+            batch.clear();
+        }
+    }
+
+public:
+    TimerService(std::chrono::milliseconds tick_length, size_t worker_threads)
+        : pool(worker_threads), tick(tick_length),
+          start(std::chrono::steady_clock::now()),
+          driver([this] { drive(); }) {}
+
+    ~TimerService() {
+        running = false;
+        driver.join();
+    }
+
+    TimerWheel::TimerId schedule_after(std::chrono::milliseconds delay, TimerWheel::Callback cb) {
+        uint64_t ticks = static_cast<uint64_t>((delay + tick - std::chrono::milliseconds(1)) / tick);
+        std::lock_guard<std::mutex> lock(wheel_mutex);
+        return wheel.schedule(ticks, std::move(cb));
+    }
+
+    bool cancel(TimerWheel::TimerId id) {
+        std::lock_guard<std::mutex> lock(wheel_mutex);
+        return wheel.cancel(id);
+    }
+
+    size_t pending() {
+        std::lock_guard<std::mutex> lock(wheel_mutex);
+        return wheel.pending();
+    }
+};
+
+// 4. 对照组：基于 std::priority_queue 的调度器（取消采用惰性标记）
+class HeapScheduler {
+private:
+    struct Entry {
+        uint64_t expire;
+        uint32_t id;
+        bool operator>(const Entry& other) const { return expire > other.expire; }
+    };
+
+    std::priority_queue<Entry, vector<Entry>, std::greater<Entry>> heap;
+    vector<TimerWheel::Callback> callbacks;
+    vector<char> cancelled;
+    uint64_t current = 0;
+
+public:
+    void reserve(size_t n) {
+        callbacks.reserve(n);
+        cancelled.reserve(n);
+    }
+
+    uint32_t schedule(uint64_t delay_ticks, TimerWheel::Callback cb) {
+        uint32_t id = static_cast<uint32_t>(callbacks.size());
+        callbacks.push_back(std::move(cb));
+        cancelled.push_back(0);
+        heap.push({current + (delay_ticks == 0 ? 1 : delay_ticks), id});
+        return id;
+    }
+
+    bool cancel(uint32_t id) {
+        if (cancelled[id]) return false;
+        cancelled[id] = 1;
+        return true;
+    }
+
+    size_t advance(uint64_t target_tick, vector<TimerWheel::Callback>& expired) {
+        size_t fired = 0;
+        current = target_tick;
+        while (!heap.empty() && heap.top().expire <= current) {
+            uint32_t id = heap.top().id;
+            heap.pop();
+            if (cancelled[id]) continue;
+            cancelled[id] = 1;
+            expired.push_back(std::move(callbacks[id]));
+            ++fired;
+        }
+        return fired;
+    }
+};
+
+void demonstrate_timer_wheel() {
+    cout << "=== 时间轮基本操作（模拟时钟）===" << endl;
+
+    TimerWheel wheel;
+    vector<TimerWheel::Callback> expired;
+
+    wheel.schedule(5, [] { cout << "  定时器 A 在 tick 5 到期" << endl; });
+    auto b = wheel.schedule(10, [] { cout << "  定时器 B（应已被取消）" << endl; });
+    wheel.schedule(300, [] { cout << "  定时器 C 在 tick 300 到期（经过一次降级）" << endl; });
+    wheel.schedule(70000, [] { cout << "  定时器 D 在 tick 70000 到期（经过两次降级）" << endl; });
+
+    cout << "取消定时器 B: " << (wheel.cancel(b) ? "成功" : "失败") << endl;
+    cout << "再次取消 B: " << (wheel.cancel(b) ? "成功" : "失败") << endl;
+    cout << "待触发定时器数: " << wheel.pending() << endl;
+
+    for (uint64_t target : {5, 299, 300, 70000}) {
+        size_t fired = wheel.advance(target, expired);
+        cout << "推进到 tick " << target << "，到期 " << fired << " 个" << endl;
+        for (auto& cb : expired) cb();
+        expired.clear();
+    }
+}
+
+void demonstrate_timer_service() {
+    cout << "\n=== 并发定时服务（真实时钟，1ms tick）===" << endl;
+
+    std::atomic<int> progress{0};
+    const int steps = 5;
+    {
+        TimerService service(std::chrono::milliseconds(1), 2);
+
+        // 用定时器代替 long_running_task 中的 sleep_for 推进进度
+        for (int i = 1; i <= steps; ++i) {
+            service.schedule_after(std::chrono::milliseconds(20 * i), [i, &progress] {
+                progress.fetch_add(1);
+                cout << "  进度回调: " + std::to_string(i) + "/" + std::to_string(steps) + "\n";
+            });
+        }
+        auto never = service.schedule_after(std::chrono::milliseconds(50), [] {
+            cout << "  不应执行的回调\n";
+        });
+        service.cancel(never);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        cout << "剩余定时器: " << service.pending() << endl;
+    }
+    cout << "完成的进度回调: " << progress.load() << "/" << steps << endl;
+}
+
+void demonstrate_performance() {
+    cout << "\n=== 性能对比：时间轮 vs 优先队列 ===" << endl;
+
+    const size_t N = 1000000;
+    const uint64_t horizon = 60000;  // 1ms tick 下的 60 秒
+    vector<uint64_t> delays(N);
+    std::mt19937_64 gen(7);
+    std::uniform_int_distribution<uint64_t> dist(1, horizon);
+    for (auto& d : delays) d = dist(gen);
+
+    auto measure = [](const string& desc, auto func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        cout << "  " << desc << ": " << us << " μs" << endl;
+    };
+
+    long long counter = 0;
+    auto make_callback = [&counter] { return [&counter] { ++counter; }; };
+
+    cout << N << " 个定时器，取消一半，推进 " << horizon << " 个 tick:" << endl;
+
+    {
+        TimerWheel wheel;
+        wheel.reserve(N);
+        vector<TimerWheel::TimerId> ids(N);
+        vector<TimerWheel::Callback> expired;
+        measure("时间轮 schedule", [&] {
+            for (size_t i = 0; i < N; ++i) ids[i] = wheel.schedule(delays[i], make_callback());
+        });
+        measure("时间轮 cancel", [&] {
+            for (size_t i = 0; i < N; i += 2) wheel.cancel(ids[i]);
+        });
+        measure("时间轮 advance + 执行", [&] {
+            for (uint64_t t = 1; t <= horizon; ++t) {
+                wheel.advance(t, expired);
+                for (auto& cb : expired) cb();
+                expired.clear();
+            }
+        });
+    }
+
+    {
+        HeapScheduler sched;
+        sched.reserve(N);
+        vector<uint32_t> ids(N);
+        vector<TimerWheel::Callback> expired;
+        measure("优先队列 schedule", [&] {
+            for (size_t i = 0; i < N; ++i) ids[i] = sched.schedule(delays[i], make_callback());
+        });
+        measure("优先队列 cancel", [&] {
+            for (size_t i = 0; i < N; i += 2) sched.cancel(ids[i]);
+        });
+        measure("优先队列 advance + 执行", [&] {
+            for (uint64_t t = 1; t <= horizon; ++t) {
+                sched.advance(t, expired);
+                for (auto& cb : expired) cb();
+                expired.clear();
+            }
+        });
+    }
+
+    cout << "回调执行次数: " << counter << " (期望 " << N << ")" << endl;
+}
+
+int main() {
+    print_separator("分层时间轮定时调度器");
+
+    demonstrate_timer_wheel();
+    demonstrate_timer_service();
+    demonstrate_performance();
+
+    cout << "\n=== 要点总结 ===" << endl;
+    cout << "1. 时间轮的调度和取消都是 O(1)，与定时器总数无关" << endl;
+    cout << "2. 高层槽在低层转完一圈时降级，每个定时器最多被移动 层数 次" << endl;
+    cout << "3. 到期回调按 tick 批量交给线程池，锁内不执行用户代码" << endl;
+    cout << "4. 用 generation 计数让已复用节点的旧 TimerId 失效" << endl;
+
+    return 0;
+}
@@ -0,0 +1,380 @@
+#include "common.h"
+#include <cstdint>
+
+// 迭代式、面向缓存的二叉树算法
+// recursive_functions.cpp 中的 tree_height / inorder_traversal / count_nodes / search_tree
+// 用递归实现并在每个节点打印，search_tree 还忽略了二叉搜索树的有序性。
+// 递归深度等于树高：退化成链表的树在百万节点时就会栈溢出。
+// 这里用显式栈实现同样的操作，并对静态树使用 BFS（Eytzinger）与 van Emde Boas 数组布局。
+
+// 1. 节点与建树
+// 节点放在一个 vector 中统一分配，树销毁时整体释放，不需要递归 delete。
+struct TreeNode {
+    int data;
+    TreeNode* left;
+    TreeNode* right;
+
+    TreeNode(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class TreePool {
+    vector<TreeNode> nodes;
+
+public:
+    explicit TreePool(size_t n) { nodes.reserve(n); }
+
+    TreeNode* make(int value) {
+        nodes.emplace_back(value);   // 已预留容量，地址不会失效
+        return &nodes.back();
+    }
+};
+
+// 随机形状：对有序键 0..n-1 赋随机优先级，用单调栈 O(n) 构建笛卡尔树（treap）。
+// 形状分布与按随机顺序逐个插入的 BST 相同，期望高度 O(log n)。
+TreeNode* build_random_bst(TreePool& pool, int n, uint32_t seed) {
+    std::mt19937 gen(seed);
+    vector<std::pair<TreeNode*, uint32_t>> spine;   // 右脊上的节点及其优先级
+    for (int key = 0; key < n; ++key) {
+        TreeNode* node = pool.make(key);
+        uint32_t priority = gen();
+        TreeNode* last = nullptr;
+        while (!spine.empty() && spine.back().second < priority) {
+            last = spine.back().first;
+            spine.pop_back();
+        }
+        node->left = last;
+        if (!spine.empty()) spine.back().first->right = node;
+        spine.push_back({node, priority});
+    }
+    return spine.empty() ? nullptr : spine.front().first;
+}
+
+// 退化形状：按升序插入得到的右斜链
+TreeNode* build_degenerate_bst(TreePool& pool, int n) {
+    TreeNode* root = nullptr;
+    TreeNode* tail = nullptr;
+    for (int key = 0; key < n; ++key) {
+        TreeNode* node = pool.make(key);
+        if (tail) tail->right = node;
+        else root = node;
+        tail = node;
+    }
+    return root;
+}
+
+// 2. 显式栈遍历
+// 栈放在堆上的 vector 中，深度只受内存限制；先压右子树再压左子树，
+// 使链状树的栈大小保持为 O(1)。
+int tree_height(const TreeNode* root) {
+    if (!root) return 0;
+    int height = 0;
+    vector<std::pair<const TreeNode*, int>> stack{{root, 1}};
+    while (!stack.empty()) {
+        auto [node, depth] = stack.back();
+        stack.pop_back();
+        height = std::max(height, depth);
+        if (node->right) stack.push_back({node->right, depth + 1});
+        if (node->left) stack.push_back({node->left, depth + 1});
+    }
+    return height;
+}
+
+size_t count_nodes(const TreeNode* root) {
+    if (!root) return 0;
+    size_t count = 0;
+    vector<const TreeNode*> stack{root};
+    while (!stack.empty()) {
+        const TreeNode* node = stack.back();
+        stack.pop_back();
+        ++count;
+        if (node->right) stack.push_back(node->right);
+        if (node->left) stack.push_back(node->left);
+    }
+    return count;
+}
+
+// 中序遍历：对每个节点调用 visit，由调用者决定是否打印
+template<typename Visit>
+void inorder_traversal(const TreeNode* root, Visit visit) {
+    vector<const TreeNode*> stack;
+    const TreeNode* node = root;
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        visit(node->data);
+        node = node->right;
+    }
+}
+
+// 按 BST 有序性查找：每层只走一侧，O(h)
+const TreeNode* search_tree(const TreeNode* root, int target) {
+    while (root && root->data != target) {
+        root = target < root->data ? root->left : root->right;
+    }
+    return root;
+}
+
+// 递归版本，仅用于对比（在退化树上会栈溢出）
+int tree_height_recursive(const TreeNode* root) {
+    if (!root) return 0;
+    return 1 + std::max(tree_height_recursive(root->left), tree_height_recursive(root->right));
+}
+
+// 3. 静态树的数组布局
+// BFS（Eytzinger）布局：下标 k 的子节点为 2k、2k+1，查找时无需存储指针；
+// 前几层集中在数组开头，总是命中缓存。
+class EytzingerTree {
+    vector<int> keys;   // keys[0] 不用
+
+    // 对隐式完全二叉树做中序遍历，依次写入有序键（显式栈）
+    void fill(const vector<int>& sorted) {
+        vector<size_t> stack;
+        size_t i = 0, k = 1;
+        while (k < keys.size() || !stack.empty()) {
+            while (k < keys.size()) {
+                stack.push_back(k);
+                k = 2 * k;
+            }
+            k = stack.back();
+            stack.pop_back();
+            keys[k] = sorted[i++];
+            k = 2 * k + 1;
+        }
+    }
+
+public:
+    explicit EytzingerTree(const vector<int>& sorted) : keys(sorted.size() + 1) {
+        fill(sorted);
+    }
+
+    // 无分支下降，结束后根据下降路径还原第一个 >= target 的位置
+    bool contains(int target) const {
+        size_t n = keys.size() - 1;
+        size_t k = 1;
+        while (k <= n) {
+            __builtin_prefetch(keys.data() + std::min(k * 16, n));
+            k = 2 * k + (keys[k] < target);
+        }
+        k >>= __builtin_ffsll(~k);
+        return k != 0 && keys[k] == target;
+    }
+};
+
+// van Emde Boas 布局：把高度为 h 的树分成高度约 h/2 的顶部子树和若干底部子树，
+// 每棵子树连续存放并递归地同样布局。任意缓存行大小下，一次查找都只触及
+// O(log_B n) 个缓存行。节点用 32 位下标链接。
+class VebTree {
+    struct Node {
+        int key;
+        int32_t left;
+        int32_t right;
+    };
+    vector<Node> nodes;
+    vector<int32_t> position;   // BFS 编号 -> vEB 位置
+
+    // 把以 BFS 编号 root 为根、高度为 height 的子树按 vEB 顺序编号
+    // 递归深度只有 O(log log n)
+    void layout(size_t root, int height, int32_t& next) {
+        size_t n = position.size() - 1;
+        if (root > n) return;
+        if (height == 1) {
+            position[root] = next++;
+            return;
+        }
+        int top = height / 2;
+        int bottom = height - top;
+        layout(root, top, next);
+        size_t first = root << top;
+        for (size_t j = 0; j < (size_t(1) << top); ++j) {
+            layout(first + j, bottom, next);
+        }
+    }
+
+public:
+    explicit VebTree(const vector<int>& sorted) : nodes(sorted.size()), position(sorted.size() + 1) {
+        size_t n = sorted.size();
+        if (n == 0) return;
+        int height = 0;
+        while ((size_t(1) << height) <= n) ++height;
+        int32_t next = 0;
+        layout(1, height, next);
+
+        // 按隐式完全二叉树的中序给节点赋键，再把 BFS 下标换成 vEB 位置
+        vector<size_t> stack;
+        size_t k = 1, i = 0;
+        while (k <= n || !stack.empty()) {
+            while (k <= n) {
+                stack.push_back(k);
+                k = 2 * k;
+            }
+            k = stack.back();
+            stack.pop_back();
+            Node& node = nodes[position[k]];
+            node.key = sorted[i++];
+            node.left = 2 * k <= n ? position[2 * k] : -1;
+            node.right = 2 * k + 1 <= n ? position[2 * k + 1] : -1;
+            k = 2 * k + 1;
+        }
+    }
+
+    bool contains(int target) const {
+        int32_t p = nodes.empty() ? -1 : 0;
+        while (p >= 0) {
+            const Node& node = nodes[p];
+            if (node.key == target) return true;
+            p = target < node.key ? node.left : node.right;
+        }
+        return false;
+    }
+};
+
+// 4. 并行子树计数
+// 先从根按层展开出足够多的子树（展开过的节点直接计数），再把子树分给各线程。
+// 退化树展开不出多棵子树，只能由一个线程完成。
+size_t parallel_count_nodes(const TreeNode* root, unsigned threads) {
+    if (!root) return 0;
+    vector<const TreeNode*> frontier{root};
+    size_t counted = 0;
+    const size_t target = threads * 8;
+    for (int step = 0; step < 64 && frontier.size() < target; ++step) {
+        vector<const TreeNode*> next;
+        for (const TreeNode* node : frontier) {
+            ++counted;
+            if (node->left) next.push_back(node->left);
+            if (node->right) next.push_back(node->right);
+        }
+        if (next.empty()) return counted;
+        frontier.swap(next);
+    }
+
+    vector<size_t> partial(threads, 0);
+    vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (size_t i = t; i < frontier.size(); i += threads) {
+                partial[t] += count_nodes(frontier[i]);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    return std::accumulate(partial.begin(), partial.end(), counted);
+}
+
+void demonstrate_basic_operations() {
+    cout << "\n=== 迭代式树操作 ===" << endl;
+
+    TreePool pool(16);
+    TreeNode* root = build_random_bst(pool, 10, 42);
+
+    cout << "随机 BST 高度: " << tree_height(root) << endl;
+    cout << "节点数: " << count_nodes(root) << endl;
+    cout << "中序遍历: ";
+    inorder_traversal(root, [](int value) { cout << value << " "; });
+    cout << endl;
+    cout << "查找 7: " << (search_tree(root, 7) ? "找到" : "未找到") << endl;
+    cout << "查找 12: " << (search_tree(root, 12) ? "找到" : "未找到") << endl;
+
+    vector<int> sorted(10);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    EytzingerTree eytzinger(sorted);
+    VebTree veb(sorted);
+    cout << "BFS 布局查找 3: " << (eytzinger.contains(3) ? "找到" : "未找到")
+         << ", vEB 布局查找 9: " << (veb.contains(9) ? "找到" : "未找到") << endl;
+}
+
+void demonstrate_performance(int n) {
+    cout << "\n=== 性能对比 (" << n << " 个节点) ===" << endl;
+
+    auto measure = [](const string& desc, auto func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        cout << "  " << desc << ": " << us << " μs" << endl;
+    };
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int degenerate = 0; degenerate < 2; ++degenerate) {
+        cout << (degenerate ? "退化树（右斜链）:" : "随机树:") << endl;
+        TreePool pool(n);
+        TreeNode* root = nullptr;
+        measure("建树", [&] {
+            root = degenerate ? build_degenerate_bst(pool, n) : build_random_bst(pool, n, 7);
+        });
+
+        int height = 0;
+        size_t count = 0, parallel = 0;
+        long long sum = 0;
+        measure("迭代求高度", [&] { height = tree_height(root); });
+        if (!degenerate) {
+            int recursive = 0;
+            measure("递归求高度", [&] { recursive = tree_height_recursive(root); });
+            cout << "    递归与迭代结果一致: " << (recursive == height ? "是" : "否") << endl;
+        } else {
+            cout << "  递归求高度: 跳过（递归深度等于节点数 " << n << "，大树会栈溢出）" << endl;
+        }
+        measure("迭代计数", [&] { count = count_nodes(root); });
+        measure("并行计数 (" + to_string(threads) + " 线程)", [&] { parallel = parallel_count_nodes(root, threads); });
+        measure("迭代中序遍历", [&] { inorder_traversal(root, [&](int v) { sum += v; }); });
+        cout << "    高度 " << height << ", 节点 " << count << "/" << parallel
+             << ", 中序和 " << sum << endl;
+
+        // 退化树上每次查找都是 O(n)，只查少量键
+        int lookups = degenerate ? 20 : 2000000;
+        std::mt19937 gen(3);
+        std::uniform_int_distribution<int> dist(0, 2 * n - 1);
+        vector<int> queries(lookups);
+        for (auto& q : queries) q = dist(gen);
+        size_t found = 0;
+        measure(to_string(lookups) + " 次 BST 查找", [&] {
+            for (int q : queries) found += search_tree(root, q) != nullptr;
+        });
+        cout << "    命中 " << found << " 次" << endl;
+    }
+
+    cout << "静态数组布局查找 (2000000 次):" << endl;
+    vector<int> sorted(n);
+    for (int i = 0; i < n; ++i) sorted[i] = 2 * i;   // 偶数键，约一半查询命中
+    EytzingerTree eytzinger(sorted);
+    VebTree veb(sorted);
+
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> dist(0, 2 * n - 1);
+    vector<int> queries(2000000);
+    for (auto& q : queries) q = dist(gen);
+
+    size_t hits[3] = {0, 0, 0};
+    measure("有序数组 binary_search", [&] {
+        for (int q : queries) hits[0] += std::binary_search(sorted.begin(), sorted.end(), q);
+    });
+    measure("BFS (Eytzinger) 布局", [&] {
+        for (int q : queries) hits[1] += eytzinger.contains(q);
+    });
+    measure("van Emde Boas 布局", [&] {
+        for (int q : queries) hits[2] += veb.contains(q);
+    });
+    cout << "    命中次数一致: " << (hits[0] == hits[1] && hits[1] == hits[2] ? "是" : "否")
+         << " (" << hits[0] << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    print_separator("迭代式、面向缓存的树算法");
+
+    demonstrate_basic_operations();
+
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    demonstrate_performance(n);
+
+    cout << "\n=== 要点总结 ===" << endl;
+    cout << "1. 显式栈放在堆上，退化树也不会栈溢出" << endl;
+    cout << "2. 按 BST 有序性查找只走一条路径，O(h) 而不是 O(n)" << endl;
+    cout << "3. 静态树用 BFS 或 vEB 数组布局，省去指针并提高缓存命中" << endl;
+    cout << "4. 展开上层得到多棵子树后并行计数；退化树无法并行" << endl;
+
+    return 0;
+}
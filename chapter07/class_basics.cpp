@@ -36,7 +36,7 @@ private:
     string name;
     int age;
     double gpa;
-    vector<string> courses;
+    vector<string> courses;  // 课程通常只有几门，small_vector.cpp 演示了内联存储的替代方案
     
 public:
     // 默认构造函数
@@ -0,0 +1,551 @@
+#include "common.h"
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+// 堆分配计数：用于对比 vector 与 SmallVector 的分配次数
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// 1. 可平凡重定位（trivially relocatable）类型萃取
+// 这类对象可以直接 memcpy 到新地址，再"忘掉"旧地址，而不必调用移动构造和析构。
+// 平凡可复制类型天然满足；unique_ptr、shared_ptr 这种不含自引用指针的类型也满足，
+// 这里显式标注。std::string（libstdc++ 的 SSO 指向自身缓冲区）不满足。
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// unique_ptr 本身只是指针加删除器，是否可重定位取决于删除器
+template<typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+// 2. SmallVector：前 N 个元素存放在对象内部，超过后才转移到堆上
+template<typename T, std::size_t N>
+class SmallVector {
+    static_assert(N > 0, "内联容量至少为 1");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    T* ptr;
+    size_type sz = 0;
+    size_type cap = N;
+    alignas(T) unsigned char inline_buf[N * sizeof(T)];
+
+    T* inline_data() { return reinterpret_cast<T*>(inline_buf); }
+    const T* inline_data() const { return reinterpret_cast<const T*>(inline_buf); }
+
+    // 把 [src, src + n) 搬到未初始化的 dst，搬完后 src 区间视为未初始化
+    static void relocate(T* src, size_type n, T* dst) {
+        if constexpr (is_trivially_relocatable<T>::value) {
+            if (n) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        } else {
+            for (size_type i = 0; i < n; ++i) {
+                new (dst + i) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    static T* allocate(size_type n) {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void release_heap() {
+        if (!is_inline()) ::operator delete(ptr);
+    }
+
+    void destroy_all() {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_type i = 0; i < sz; ++i) ptr[i].~T();
+        }
+        sz = 0;
+    }
+
+    size_type grow_capacity(size_type min_cap) const {
+        size_type new_cap = cap * 2;
+        return new_cap < min_cap ? min_cap : new_cap;
+    }
+
+    void reallocate(size_type new_cap) {
+        T* new_data = allocate(new_cap);
+        relocate(ptr, sz, new_data);
+        release_heap();
+        ptr = new_data;
+        cap = new_cap;
+    }
+
+    // 从 other 接管元素：堆上的直接偷指针，内联的逐个重定位
+    void steal(SmallVector& other) {
+        if (other.is_inline()) {
+            ptr = inline_data();
+            cap = N;
+            relocate(other.ptr, other.sz, ptr);
+        } else {
+            ptr = other.ptr;
+            cap = other.cap;
+            other.ptr = other.inline_data();
+            other.cap = N;
+        }
+        sz = other.sz;
+        other.sz = 0;
+    }
+
+public:
+    SmallVector() : ptr(inline_data()) {}
+
+    explicit SmallVector(size_type count) : SmallVector() {
+        resize(count);
+    }
+
+    SmallVector(size_type count, const T& value) : SmallVector() {
+        assign(count, value);
+    }
+
+    SmallVector(std::initializer_list<T> init) : SmallVector() {
+        assign(init.begin(), init.end());
+    }
+
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    SmallVector(InputIt first, InputIt last) : SmallVector() {
+        assign(first, last);
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept(is_trivially_relocatable<T>::value ||
+                                              std::is_nothrow_move_constructible<T>::value)
+        : SmallVector() {
+        steal(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(is_trivially_relocatable<T>::value ||
+                                                         std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            destroy_all();
+            release_heap();
+            ptr = inline_data();
+            cap = N;
+            steal(other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~SmallVector() {
+        destroy_all();
+        release_heap();
+    }
+
+    // 赋值
+    void assign(size_type count, const T& value) {
+        clear();
+        reserve(count);
+        for (size_type i = 0; i < count; ++i) new (ptr + i) T(value);
+        sz = count;
+    }
+
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+                          typename std::iterator_traits<InputIt>::iterator_category>::value) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) emplace_back(*first);
+    }
+
+    // 元素访问
+    T& operator[](size_type i) { return ptr[i]; }
+    const T& operator[](size_type i) const { return ptr[i]; }
+
+    T& at(size_type i) {
+        if (i >= sz) throw std::out_of_range("SmallVector::at 下标越界");
+        return ptr[i];
+    }
+    const T& at(size_type i) const {
+        if (i >= sz) throw std::out_of_range("SmallVector::at 下标越界");
+        return ptr[i];
+    }
+
+    T& front() { return ptr[0]; }
+    const T& front() const { return ptr[0]; }
+    T& back() { return ptr[sz - 1]; }
+    const T& back() const { return ptr[sz - 1]; }
+    T* data() noexcept { return ptr; }
+    const T* data() const noexcept { return ptr; }
+
+    // 迭代器
+    iterator begin() noexcept { return ptr; }
+    const_iterator begin() const noexcept { return ptr; }
+    const_iterator cbegin() const noexcept { return ptr; }
+    iterator end() noexcept { return ptr + sz; }
+    const_iterator end() const noexcept { return ptr + sz; }
+    const_iterator cend() const noexcept { return ptr + sz; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // 容量
+    bool empty() const noexcept { return sz == 0; }
+    size_type size() const noexcept { return sz; }
+    size_type capacity() const noexcept { return cap; }
+    static constexpr size_type inline_capacity() noexcept { return N; }
+    bool is_inline() const noexcept { return ptr == inline_data(); }
+
+    void reserve(size_type new_cap) {
+        if (new_cap > cap) reallocate(new_cap);
+    }
+
+    // 元素重新放得下时回到内联存储
+    void shrink_to_fit() {
+        if (is_inline() || sz == cap) return;
+        if (sz <= N) {
+            T* old = ptr;
+            relocate(old, sz, inline_data());
+            ::operator delete(old);
+            ptr = inline_data();
+            cap = N;
+        } else {
+            reallocate(sz);
+        }
+    }
+
+    // 修改器
+    void clear() noexcept { destroy_all(); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (sz == cap) {
+            // 先在新缓冲区构造新元素，再搬旧元素，这样 args 引用自身元素也安全
+            size_type new_cap = grow_capacity(sz + 1);
+            T* new_data = allocate(new_cap);
+            new (new_data + sz) T(std::forward<Args>(args)...);
+            relocate(ptr, sz, new_data);
+            release_heap();
+            ptr = new_data;
+            cap = new_cap;
+        } else {
+            new (ptr + sz) T(std::forward<Args>(args)...);
+        }
+        return ptr[sz++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        ptr[--sz].~T();
+    }
+
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        size_type index = static_cast<size_type>(pos - ptr);
+        if (index == sz) {
+            emplace_back(std::forward<Args>(args)...);
+            return ptr + index;
+        }
+        T tmp(std::forward<Args>(args)...);
+        emplace_back(std::move(back()));
+        std::move_backward(ptr + index, ptr + sz - 2, ptr + sz - 1);
+        ptr[index] = std::move(tmp);
+        return ptr + index;
+    }
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        size_type index = static_cast<size_type>(pos - ptr);
+        size_type old_size = sz;
+        for (; first != last; ++first) emplace_back(*first);
+        std::rotate(ptr + index, ptr + old_size, ptr + sz);
+        return ptr + index;
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T* f = ptr + (first - ptr);
+        T* l = ptr + (last - ptr);
+        if (f != l) {
+            T* new_end = std::move(l, ptr + sz, f);
+            for (T* p = new_end; p != ptr + sz; ++p) p->~T();
+            sz = static_cast<size_type>(new_end - ptr);
+        }
+        return f;
+    }
+
+    void resize(size_type count) {
+        if (count < sz) {
+            erase(begin() + count, end());
+        } else {
+            reserve(count);
+            for (size_type i = sz; i < count; ++i) new (ptr + i) T();
+            sz = count;
+        }
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count < sz) {
+            erase(begin() + count, end());
+        } else {
+            while (sz < count) emplace_back(value);
+        }
+    }
+
+    void swap(SmallVector& other) {
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend bool operator==(const SmallVector& a, const SmallVector& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator!=(const SmallVector& a, const SmallVector& b) { return !(a == b); }
+    friend bool operator<(const SmallVector& a, const SmallVector& b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
+
+template<typename T, std::size_t N>
+void swap(SmallVector<T, N>& a, SmallVector<T, N>& b) { a.swap(b); }
+
+// 3. 基准测试用的类：与 class_basics.cpp 的 Student、class_composition.cpp 的 Classroom、
+// advanced_functions.cpp 的 EventManager 结构相同，但去掉了每次构造时的输出，
+// 并把"短集合"的容器类型作为模板参数
+template<typename CourseList>
+class BasicStudent {
+private:
+    string name;
+    int age;
+    double gpa;
+    CourseList courses;
+
+public:
+    BasicStudent(const string& n, int a, double g) : name(n), age(a), gpa(g) {}
+
+    void addCourse(const string& course) { courses.push_back(course); }
+
+    bool hasCourse(const string& course) const {
+        return std::find(courses.begin(), courses.end(), course) != courses.end();
+    }
+
+    double calculateCredits() const { return courses.size() * 3.0; }
+    int getAge() const { return age; }
+    double getGpa() const { return gpa; }
+};
+
+template<typename StudentList>
+class BasicClassroom {
+private:
+    int classId;
+    StudentList students;
+
+public:
+    explicit BasicClassroom(int id) : classId(id) {}
+
+    template<typename S>
+    void addStudent(S* student) { students.push_back(student); }
+
+    double averageGpa() const {
+        if (students.empty()) return 0.0;
+        double sum = 0.0;
+        for (const auto* s : students) sum += s->getGpa();
+        return sum / students.size();
+    }
+};
+
+template<typename HandlerList>
+class BasicEventManager {
+private:
+    HandlerList handlers;  // 单个对象的"点击"事件处理器，通常只有 1~3 个
+
+public:
+    template<typename F>
+    void subscribe(F&& handler) { handlers.emplace_back(std::forward<F>(handler)); }
+
+    void publish(int data) {
+        for (auto& handler : handlers) handler(data);
+    }
+};
+
+using Handler = std::function<void(int)>;
+
+void demonstrateBasicUsage() {
+    cout << "=== SmallVector 基本用法 ===" << endl;
+
+    SmallVector<int, 4> v{1, 2, 3};
+    cout << "初始: ";
+    print_container(v);
+    cout << "size=" << v.size() << " capacity=" << v.capacity()
+         << " 内联=" << (v.is_inline() ? "是" : "否") << endl;
+
+    v.push_back(4);
+    cout << "push_back(4) 后仍内联: " << (v.is_inline() ? "是" : "否") << endl;
+
+    v.push_back(5);
+    cout << "push_back(5) 后溢出到堆: " << (v.is_inline() ? "否" : "是")
+         << ", capacity=" << v.capacity() << endl;
+
+    v.insert(v.begin() + 1, 100);
+    v.erase(v.begin() + 3);
+    cout << "insert/erase 后: ";
+    print_container(v);
+
+    v.resize(3);
+    v.shrink_to_fit();
+    cout << "resize(3) + shrink_to_fit 后回到内联: " << (v.is_inline() ? "是" : "否") << endl;
+
+    SmallVector<string, 2> names{"张三", "李四"};
+    SmallVector<string, 2> moved(std::move(names));
+    cout << "移动构造 string 元素: ";
+    print_container(moved);
+
+    SmallVector<std::unique_ptr<int>, 2> owners;
+    owners.push_back(make_unique<int>(7));
+    owners.push_back(make_unique<int>(8));
+    owners.push_back(make_unique<int>(9));  // 扩容时按位复制（可平凡重定位）
+    cout << "unique_ptr 元素: ";
+    for (const auto& p : owners) cout << *p << " ";
+    cout << endl;
+
+    std::vector<int> from_vector(v.begin(), v.end());
+    cout << "可与标准算法/容器互操作: sum = "
+         << std::accumulate(from_vector.begin(), from_vector.end(), 0) << endl;
+
+    try {
+        v.at(10);
+    } catch (const std::out_of_range& e) {
+        cout << "at 越界: " << e.what() << endl;
+    }
+}
+
+// 4. 百万实例性能对比
+template<typename CourseList, typename StudentList, typename HandlerList>
+void runWorkload(const string& label, int count) {
+    using StudentT = BasicStudent<CourseList>;
+    static const char* course_names[] = {"数学", "物理", "化学", "算法", "英语", "历史"};
+
+    std::size_t alloc_before = g_allocations;
+    Timer timer;
+
+    std::vector<StudentT> students;
+    students.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        students.emplace_back("S", 18 + i % 6, (i % 40) / 10.0);
+        int courses = 2 + i % 5;  // 每人 2~6 门课
+        for (int c = 0; c < courses; ++c) students.back().addCourse(course_names[c]);
+    }
+    double build_students = timer.elapsed();
+
+    timer.reset();
+    std::vector<BasicClassroom<StudentList>> rooms;
+    rooms.reserve(count / 6);
+    for (int i = 0; i + 6 <= count; i += 6) {
+        rooms.emplace_back(i);
+        for (int j = 0; j < 6; ++j) rooms.back().addStudent(&students[i + j]);
+    }
+    double build_rooms = timer.elapsed();
+
+    timer.reset();
+    long long hits = 0;
+    std::vector<BasicEventManager<HandlerList>> widgets(count);
+    for (int i = 0; i < count; ++i) {
+        widgets[i].subscribe([&hits](int d) { hits += d; });
+        widgets[i].subscribe([&hits](int d) { hits -= d / 2; });
+    }
+    double build_events = timer.elapsed();
+    std::size_t allocations = g_allocations - alloc_before;
+
+    timer.reset();
+    double credits = 0.0;
+    int with_algo = 0;
+    for (const auto& s : students) {
+        credits += s.calculateCredits();
+        with_algo += s.hasCourse("算法");
+    }
+    double gpa = 0.0;
+    for (const auto& r : rooms) gpa += r.averageGpa();
+    for (auto& w : widgets) w.publish(2);
+    double scan = timer.elapsed();
+
+    cout << std::fixed << std::setprecision(1);
+    cout << label << ":" << endl;
+    cout << "  构建学生 " << build_students << " ms, 构建班级 " << build_rooms
+         << " ms, 构建事件管理器 " << build_events << " ms" << endl;
+    cout << "  遍历/查询/分发 " << scan << " ms, 堆分配次数 " << allocations << endl;
+    cout << "  sizeof(Student)=" << sizeof(StudentT)
+         << " sizeof(Classroom)=" << sizeof(BasicClassroom<StudentList>)
+         << " sizeof(EventManager)=" << sizeof(BasicEventManager<HandlerList>) << endl;
+    cout << "  (校验: " << credits << " " << with_algo << " " << gpa << " " << hits << ")" << endl;
+    cout << std::defaultfloat;
+}
+
+void demonstratePerformance(int count) {
+    cout << "\n=== 性能对比（" << count << " 个实例）===" << endl;
+
+    // 内联容量会直接计入对象大小：N 应覆盖常见规模，而不是最大规模
+    using SV_Student = BasicStudent<SmallVector<string, 8>>;
+    using V_Student = BasicStudent<vector<string>>;
+
+    runWorkload<vector<string>, vector<const V_Student*>, vector<Handler>>(
+        "std::vector", count);
+    runWorkload<SmallVector<string, 8>, SmallVector<const SV_Student*, 8>, SmallVector<Handler, 4>>(
+        "SmallVector<T, 8/4>", count);
+}
+
+int main(int argc, char* argv[]) {
+    print_separator("SmallVector：内联存储的短集合");
+
+    // 1. 基本用法
+    demonstrateBasicUsage();
+
+    // 2. 性能对比，可通过命令行参数指定实例数
+    int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    demonstratePerformance(count);
+
+    return 0;
+}
@@ -0,0 +1,641 @@
+/**
+ * @file concurrent_queues.cpp
+ * @brief 并发有界队列演示 - SPSC 环形缓冲、Vyukov MPMC 环形缓冲、阻塞队列
+ *
+ * container_adapters.cpp 中的 BoundedQueue 基于 std::queue，不是线程安全的。
+ * 本文件给出三种并发有界队列：
+ *   - SpscRing：单生产者单消费者，无等待，缓存对端下标减少缓存行争用
+ *   - MpmcRing：多生产者多消费者，每个槽位带序号（Dmitry Vyukov 算法）
+ *   - BlockingQueue：在上面任一环形缓冲之上加 futex/条件变量挂起
+ * 以及吞吐量与往返延迟的性能测试。
+ */
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <climits>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+// 避免伪共享：生产者和消费者的下标放在不同缓存行
+constexpr std::size_t kCacheLine = 64;
+
+inline std::size_t round_up_pow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// ===== SPSC 环形缓冲 =====
+// 生产者只写 tail，消费者只写 head；各自缓存对方下标，
+// 只有缓存值显示满/空时才重新读取对方的原子变量
+template<typename T>
+class SpscRing {
+private:
+    using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    const std::size_t mask;
+    std::unique_ptr<Storage[]> slots;
+
+    alignas(kCacheLine) std::atomic<std::size_t> head{0};  // 消费者写
+    std::size_t cached_tail = 0;                           // 消费者私有
+    alignas(kCacheLine) std::atomic<std::size_t> tail{0};  // 生产者写
+    std::size_t cached_head = 0;                           // 生产者私有
+
+    T* slot(std::size_t i) { return reinterpret_cast<T*>(&slots[i & mask]); }
+
+public:
+    explicit SpscRing(std::size_t capacity)
+        : mask(round_up_pow2(std::max<std::size_t>(capacity, 2)) - 1),
+          slots(new Storage[mask + 1]) {}
+
+    ~SpscRing() {
+        T value;
+        while (try_pop(value)) {}
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    template<typename U>
+    bool try_push(U&& value) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cached_head > mask) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (t - cached_head > mask) return false;
+        }
+        new (slot(t)) T(std::forward<U>(value));
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h == cached_tail) return false;
+        }
+        T* p = slot(h);
+        value = std::move(*p);
+        p->~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 批量入队：一次发布多个元素，只做一次 release 写；返回实际入队个数
+    template<typename It>
+    std::size_t try_push_batch(It first, std::size_t count) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t free_slots = capacity() - (t - cached_head);
+        if (free_slots < count) {
+            cached_head = head.load(std::memory_order_acquire);
+            free_slots = capacity() - (t - cached_head);
+        }
+        std::size_t n = std::min(count, free_slots);
+        for (std::size_t i = 0; i < n; ++i, ++first) {
+            new (slot(t + i)) T(std::move(*first));
+        }
+        if (n > 0) tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // 批量出队：最多取 max_count 个写入 out；返回实际出队个数
+    template<typename OutIt>
+    std::size_t try_pop_batch(OutIt out, std::size_t max_count) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        std::size_t available = cached_tail - h;
+        if (available < max_count) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            available = cached_tail - h;
+        }
+        std::size_t n = std::min(max_count, available);
+        for (std::size_t i = 0; i < n; ++i, ++out) {
+            T* p = slot(h + i);
+            *out = std::move(*p);
+            p->~T();
+        }
+        if (n > 0) head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    std::size_t size_approx() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+};
+
+// ===== MPMC 环形缓冲（Vyukov）=====
+// 每个槽位的 sequence 表示它当前可被哪个下标的生产者/消费者使用：
+// sequence == pos 时可写，sequence == pos + 1 时可读
+template<typename T>
+class MpmcRing {
+private:
+    struct alignas(kCacheLine) Cell {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(kCacheLine) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(kCacheLine) std::atomic<std::size_t> dequeue_pos{0};
+
+public:
+    explicit MpmcRing(std::size_t capacity)
+        : mask(round_up_pow2(std::max<std::size_t>(capacity, 2)) - 1),
+          cells(new Cell[mask + 1]) {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcRing() {
+        T value;
+        while (try_pop(value)) {}
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    template<typename U>
+    bool try_push(U&& value) {
+        Cell* cell;
+        std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // 队列已满
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        new (&cell->storage) T(std::forward<U>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        Cell* cell;
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // 队列为空
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        T* p = reinterpret_cast<T*>(&cell->storage);
+        value = std::move(*p);
+        p->~T();
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // MPMC 的批量操作逐个抢占槽位，省掉的是调用方的循环与唤醒次数
+    template<typename It>
+    std::size_t try_push_batch(It first, std::size_t count) {
+        std::size_t n = 0;
+        while (n < count && try_push(std::move(*first))) {
+            ++n;
+            ++first;
+        }
+        return n;
+    }
+
+    template<typename OutIt>
+    std::size_t try_pop_batch(OutIt out, std::size_t max_count) {
+        std::size_t n = 0;
+        T value;
+        while (n < max_count && try_pop(value)) {
+            *out = std::move(value);
+            ++out;
+            ++n;
+        }
+        return n;
+    }
+};
+
+// ===== 挂起/唤醒原语 =====
+// 经典 eventcount：等待方先登记再检查条件，通知方只有在有人等待时才进入内核
+class Parker {
+private:
+    std::atomic<std::uint32_t> epoch{0};
+    std::atomic<int> waiters{0};
+#if !defined(__linux__)
+    std::mutex mtx;
+    std::condition_variable cv;
+#endif
+
+public:
+    std::uint32_t prepare_wait() {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        return epoch.load(std::memory_order_seq_cst);
+    }
+
+    void cancel_wait() {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // 等待 epoch 离开 key 或超时
+    template<typename Clock, typename Duration>
+    void wait(std::uint32_t key, const std::chrono::time_point<Clock, Duration>& deadline) {
+#if defined(__linux__)
+        auto remaining = deadline - Clock::now();
+        if (remaining > remaining.zero()) {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch),
+                    FUTEX_WAIT_PRIVATE, key, &ts, nullptr, 0);
+        }
+#else
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait_until(lock, deadline, [&] { return epoch.load() != key; });
+#endif
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_all() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) return;
+#if defined(__linux__)
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch),
+                FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            epoch.fetch_add(1, std::memory_order_seq_cst);
+        }
+        cv.notify_all();
+#endif
+    }
+};
+
+// ===== 阻塞队列 =====
+// Ring 为 SpscRing<T> 或 MpmcRing<T>；先短暂自旋，失败后挂起
+template<typename T, template<typename> class Ring = MpmcRing>
+class BlockingQueue {
+private:
+    Ring<T> ring;
+    Parker not_empty;
+    Parker not_full;
+
+    static constexpr int kSpinCount = 64;
+
+    template<typename TryOp, typename Clock, typename Duration>
+    static bool wait_until(TryOp try_op, Parker& parker,
+                           const std::chrono::time_point<Clock, Duration>& deadline) {
+        for (int i = 0; i < kSpinCount; ++i) {
+            if (try_op()) return true;
+            std::this_thread::yield();
+        }
+        for (;;) {
+            std::uint32_t key = parker.prepare_wait();
+            if (try_op()) {
+                parker.cancel_wait();
+                return true;
+            }
+            if (Clock::now() >= deadline) {
+                parker.cancel_wait();
+                return false;
+            }
+            parker.wait(key, deadline);
+        }
+    }
+
+public:
+    explicit BlockingQueue(std::size_t capacity) : ring(capacity) {}
+
+    bool try_push(const T& value) {
+        if (!ring.try_push(value)) return false;
+        not_empty.notify_all();
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        if (!ring.try_pop(value)) return false;
+        not_full.notify_all();
+        return true;
+    }
+
+    template<typename Rep, typename Period>
+    bool push_for(const T& value, const std::chrono::duration<Rep, Period>& timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        if (!wait_until([&] { return ring.try_push(value); }, not_full, deadline)) return false;
+        not_empty.notify_all();
+        return true;
+    }
+
+    template<typename Rep, typename Period>
+    bool pop_for(T& value, const std::chrono::duration<Rep, Period>& timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        if (!wait_until([&] { return ring.try_pop(value); }, not_empty, deadline)) return false;
+        not_full.notify_all();
+        return true;
+    }
+
+    void push(const T& value) {
+        while (!push_for(value, std::chrono::seconds(1))) {}
+    }
+
+    void pop(T& value) {
+        while (!pop_for(value, std::chrono::seconds(1))) {}
+    }
+
+    // 批量阻塞入队：全部入队后返回，每批只唤醒一次消费者
+    template<typename It>
+    void push_batch(It first, std::size_t count) {
+        while (count > 0) {
+            std::size_t n = 0;
+            wait_until([&] { n = ring.try_push_batch(first, count); return n > 0; },
+                       not_full, std::chrono::steady_clock::time_point::max());
+            std::advance(first, n);
+            count -= n;
+            not_empty.notify_all();
+        }
+    }
+
+    // 批量阻塞出队：至少取到一个元素后返回
+    template<typename OutIt>
+    std::size_t pop_batch(OutIt out, std::size_t max_count) {
+        std::size_t n = 0;
+        wait_until([&] { n = ring.try_pop_batch(out, max_count); return n > 0; },
+                   not_empty, std::chrono::steady_clock::time_point::max());
+        not_full.notify_all();
+        return n;
+    }
+};
+
+// 性能对比基线：互斥量保护的 std::queue
+template<typename T>
+class MutexQueue {
+private:
+    std::queue<T> queue;
+    std::size_t max_size;
+    std::mutex mtx;
+
+public:
+    explicit MutexQueue(std::size_t max_sz) : max_size(max_sz) {}
+
+    bool try_push(const T& value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (queue.size() >= max_size) return false;
+        queue.push(value);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (queue.empty()) return false;
+        value = std::move(queue.front());
+        queue.pop();
+        return true;
+    }
+};
+
+void demonstrate_spsc_ring() {
+    std::cout << "\n=== SPSC 环形缓冲 ===\n";
+
+    SpscRing<std::string> ring(4);
+    std::cout << "容量（向上取 2 的幂）: " << ring.capacity() << "\n";
+
+    for (const char* s : {"A", "B", "C", "D", "E"}) {
+        bool ok = ring.try_push(std::string(s));
+        std::cout << "try_push(" << s << "): " << std::boolalpha << ok << "\n";
+    }
+
+    std::string value;
+    while (ring.try_pop(value)) {
+        std::cout << "try_pop: " << value << "\n";
+    }
+
+    std::vector<int> batch{1, 2, 3, 4, 5, 6};
+    SpscRing<int> int_ring(8);
+    std::size_t pushed = int_ring.try_push_batch(batch.begin(), batch.size());
+    std::vector<int> out(8);
+    std::size_t popped = int_ring.try_pop_batch(out.begin(), out.size());
+    std::cout << "批量入队 " << pushed << " 个，批量出队 " << popped << " 个: ";
+    for (std::size_t i = 0; i < popped; ++i) std::cout << out[i] << " ";
+    std::cout << "\n";
+}
+
+void demonstrate_mpmc_ring() {
+    std::cout << "\n=== MPMC 环形缓冲 ===\n";
+
+    const int producers = 2;
+    const int consumers = 2;
+    const int per_producer = 10000;
+    MpmcRing<int> ring(1024);
+    std::atomic<long long> total{0};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (int i = 1; i <= per_producer; ++i) {
+                while (!ring.try_push(p * per_producer + i)) std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            int value;
+            while (consumed.load() < producers * per_producer) {
+                if (ring.try_pop(value)) {
+                    total += value;
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    long long n = producers * per_producer;
+    std::cout << producers << " 个生产者 / " << consumers << " 个消费者, 共 " << consumed.load()
+              << " 个元素, 总和 " << total.load() << " (期望 " << n * (n + 1) / 2 << ")\n";
+}
+
+void demonstrate_blocking_queue() {
+    std::cout << "\n=== 阻塞队列 ===\n";
+
+    BlockingQueue<int> queue(2);
+    int value = 0;
+
+    bool got = queue.pop_for(value, std::chrono::milliseconds(50));
+    std::cout << "空队列 pop_for(50ms): " << std::boolalpha << got << "\n";
+
+    queue.push(1);
+    queue.push(2);
+    bool pushed = queue.push_for(3, std::chrono::milliseconds(50));
+    std::cout << "满队列 push_for(50ms): " << pushed << "\n";
+
+    // 消费者阻塞等待，生产者稍后唤醒
+    std::thread consumer([&]() {
+        int v;
+        for (int i = 0; i < 4; ++i) {
+            queue.pop(v);
+            std::cout << "   消费者取到: " << v << "\n";
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::vector<int> batch{3, 4};
+    queue.push_batch(batch.begin(), batch.size());
+    consumer.join();
+
+    BlockingQueue<int, SpscRing> spsc_queue(16);
+    std::thread producer([&]() {
+        for (int i = 0; i < 5; ++i) spsc_queue.push(i * 10);
+    });
+    std::vector<int> received(5);
+    std::size_t count = 0;
+    while (count < received.size()) {
+        count += spsc_queue.pop_batch(received.begin() + count, received.size() - count);
+    }
+    producer.join();
+    std::cout << "SPSC 阻塞队列批量出队: ";
+    for (int v : received) std::cout << v << " ";
+    std::cout << "\n";
+}
+
+template<typename Queue>
+long long measure_throughput(int producers, int consumers, int total_items, std::size_t capacity) {
+    Queue queue(capacity);
+    std::atomic<int> consumed{0};
+    std::atomic<bool> start{false};
+    int per_producer = total_items / producers;
+    int expected = per_producer * producers;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            while (!start.load()) std::this_thread::yield();
+            for (int i = 0; i < per_producer; ++i) {
+                while (!queue.try_push(i)) std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            while (!start.load()) std::this_thread::yield();
+            int value;
+            while (consumed.load(std::memory_order_relaxed) < expected) {
+                if (queue.try_pop(value)) {
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    start = true;
+    for (auto& t : threads) t.join();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+}
+
+// 往返延迟：两条队列之间来回传递一个令牌
+template<typename Queue>
+double measure_round_trip(int rounds) {
+    Queue ping(64), pong(64);
+    std::thread echo([&]() {
+        int v;
+        for (int i = 0; i < rounds; ++i) {
+            while (!ping.try_pop(v)) std::this_thread::yield();
+            while (!pong.try_push(v)) std::this_thread::yield();
+        }
+    });
+    auto t0 = std::chrono::high_resolution_clock::now();
+    int v;
+    for (int i = 0; i < rounds; ++i) {
+        while (!ping.try_push(i)) std::this_thread::yield();
+        while (!pong.try_pop(v)) std::this_thread::yield();
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    echo.join();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+}
+
+void demonstrate_performance() {
+    std::cout << "\n=== 性能对比 ===\n";
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency() << "\n";
+
+    const int N = 1000000;
+    const std::size_t capacity = 1024;
+    auto report = [&](const std::string& desc, long long us) {
+        double mops = us > 0 ? static_cast<double>(N) / us : 0.0;
+        std::cout << "   " << desc << ": " << us << " μs (" << mops << " M ops/s)\n";
+    };
+
+    std::cout << "\n吞吐量 1P/1C (" << N << " 个元素):\n";
+    report("MutexQueue", measure_throughput<MutexQueue<int>>(1, 1, N, capacity));
+    report("SpscRing", measure_throughput<SpscRing<int>>(1, 1, N, capacity));
+    report("MpmcRing", measure_throughput<MpmcRing<int>>(1, 1, N, capacity));
+    report("BlockingQueue<Spsc>", measure_throughput<BlockingQueue<int, SpscRing>>(1, 1, N, capacity));
+
+    for (int threads : {2, 4}) {
+        std::cout << "\n吞吐量 " << threads << "P/" << threads << "C:\n";
+        report("MutexQueue", measure_throughput<MutexQueue<int>>(threads, threads, N, capacity));
+        report("MpmcRing", measure_throughput<MpmcRing<int>>(threads, threads, N, capacity));
+        report("BlockingQueue<Mpmc>",
+               measure_throughput<BlockingQueue<int, MpmcRing>>(threads, threads, N, capacity));
+    }
+
+    const int rounds = 100000;
+    std::cout << "\n往返延迟 (" << rounds << " 次):\n";
+    std::cout << "   MutexQueue: " << measure_round_trip<MutexQueue<int>>(rounds) << " ns\n";
+    std::cout << "   SpscRing: " << measure_round_trip<SpscRing<int>>(rounds) << " ns\n";
+    std::cout << "   MpmcRing: " << measure_round_trip<MpmcRing<int>>(rounds) << " ns\n";
+}
+
+int main() {
+    std::cout << "C++ Primer Chapter 9: 并发有界队列\n";
+    std::cout << "===============================\n";
+
+    demonstrate_spsc_ring();
+    demonstrate_mpmc_ring();
+    demonstrate_blocking_queue();
+    demonstrate_performance();
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
@@ -0,0 +1,395 @@
+/**
+ * @file concurrent_stack.cpp
+ * @brief 无锁栈演示 - 带标签的 Treiber 栈与消除回退（elimination backoff）
+ *
+ * class_templates.cpp 的 Stack<T> 和 container_adapters.cpp 的 MyStack 都是单线程的。
+ * 空闲链表、工作项回收这类场景需要并发的 LIFO：
+ *   - TaggedIndexStack：节点用 32 位下标表示，栈顶与 32 位版本号打包进一个 64 位原子量，
+ *     每次成功修改都让版本号加 1，从而避免 ABA 问题（无需 128 位 CAS）
+ *   - EliminationArray：高争用时，一对 push/pop 在随机槽位上直接交换元素，
+ *     互相抵消而不必访问栈顶
+ *   - TreiberStack：基于预分配节点池的有界并发栈，空闲节点本身也用无锁栈管理
+ * 以及与互斥量保护的 std::stack 在 1~64 线程下的性能对比。
+ */
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <stack>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 避免伪共享：栈顶和消除槽位各占一个缓存行
+constexpr std::size_t kCacheLine = 64;
+
+inline void cpu_relax() {
+#if defined(__SSE2__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// 每线程一个 xorshift 随机数，用于选取消除槽位
+inline std::uint32_t thread_random() {
+    thread_local std::uint32_t state =
+        static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// ===== 带标签的下标栈 =====
+// head = (tag << 32) | (index + 1)，低 32 位为 0 表示空栈。
+// 经典 ABA：线程 A 读到栈顶 X 和 next=Y 后被挂起，其他线程弹出 X、Y 再压回 X，
+// A 的 CAS(X -> Y) 仍会成功却把已被占用的 Y 接回栈顶。带上版本号后 head 已不同，CAS 失败。
+class TaggedIndexStack {
+public:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    enum class PopResult { Ok, Empty, Contended };
+
+private:
+    alignas(kCacheLine) std::atomic<std::uint64_t> head{0};
+    std::atomic<std::uint32_t>* links;  // links[i] = 下一节点下标 + 1，多个栈可共享
+
+    static std::uint64_t pack(std::uint32_t tag, std::uint32_t slot) {
+        return (static_cast<std::uint64_t>(tag) << 32) | slot;
+    }
+    static std::uint32_t tag_of(std::uint64_t h) { return static_cast<std::uint32_t>(h >> 32); }
+    static std::uint32_t slot_of(std::uint64_t h) { return static_cast<std::uint32_t>(h); }
+
+public:
+    explicit TaggedIndexStack(std::atomic<std::uint32_t>* shared_links) : links(shared_links) {}
+
+    // 单次尝试，失败说明有其他线程同时修改了栈顶
+    bool try_push_once(std::uint32_t index) {
+        std::uint64_t old = head.load(std::memory_order_relaxed);
+        links[index].store(slot_of(old), std::memory_order_relaxed);
+        return head.compare_exchange_strong(old, pack(tag_of(old) + 1, index + 1),
+                                            std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    PopResult try_pop_once(std::uint32_t& index) {
+        std::uint64_t old = head.load(std::memory_order_acquire);
+        if (slot_of(old) == 0) return PopResult::Empty;
+        std::uint32_t top = slot_of(old) - 1;
+        // 读到的 next 可能已过期，但此时 head 的版本号也必然变了，下面的 CAS 会失败
+        std::uint32_t next = links[top].load(std::memory_order_relaxed);
+        if (head.compare_exchange_strong(old, pack(tag_of(old) + 1, next),
+                                         std::memory_order_acquire, std::memory_order_relaxed)) {
+            index = top;
+            return PopResult::Ok;
+        }
+        return PopResult::Contended;
+    }
+
+    void push(std::uint32_t index) {
+        while (!try_push_once(index)) {}
+    }
+
+    std::uint32_t pop() {
+        std::uint32_t index;
+        while (true) {
+            PopResult r = try_pop_once(index);
+            if (r == PopResult::Ok) return index;
+            if (r == PopResult::Empty) return npos;
+        }
+    }
+
+    std::uint32_t version() const { return tag_of(head.load()); }
+};
+
+// ===== 消除数组 =====
+// 槽位状态：0 空闲，1 已被取走，>= 2 表示 push 方挂出的下标（index + 2）。
+// push 方挂出下标后自旋等待；pop 方在随机槽位上看到挂出的下标就把它取走。
+// 这样配对成功的 push/pop 相当于在同一时刻先后发生，保持 LIFO 语义。
+class EliminationArray {
+private:
+    static constexpr std::uint64_t kEmpty = 0;
+    static constexpr std::uint64_t kTaken = 1;
+
+    struct alignas(kCacheLine) Slot {
+        std::atomic<std::uint64_t> state{kEmpty};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t slot_count;
+    int spin_limit;
+
+public:
+    explicit EliminationArray(std::size_t count = 8, int spins = 128)
+        : slots(new Slot[count]), slot_count(count), spin_limit(spins) {}
+
+    // 挂出 index 等待 pop 方取走；超时撤回则返回 false
+    bool offer_push(std::uint32_t index) {
+        Slot& slot = slots[thread_random() % slot_count];
+        std::uint64_t expected = kEmpty;
+        std::uint64_t offer = static_cast<std::uint64_t>(index) + 2;
+        if (!slot.state.compare_exchange_strong(expected, offer, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+            return false;
+        }
+        for (int i = 0; i < spin_limit; ++i) {
+            if (slot.state.load(std::memory_order_acquire) == kTaken) {
+                slot.state.store(kEmpty, std::memory_order_relaxed);
+                return true;
+            }
+            cpu_relax();
+        }
+        expected = offer;
+        if (slot.state.compare_exchange_strong(expected, kEmpty, std::memory_order_relaxed)) {
+            return false;
+        }
+        // 撤回失败说明刚好被取走
+        slot.state.store(kEmpty, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 尝试在随机槽位上取走一个挂出的下标
+    std::uint32_t try_take() {
+        Slot& slot = slots[thread_random() % slot_count];
+        std::uint64_t seen = slot.state.load(std::memory_order_acquire);
+        if (seen >= 2 && slot.state.compare_exchange_strong(seen, kTaken, std::memory_order_acquire,
+                                                            std::memory_order_relaxed)) {
+            return static_cast<std::uint32_t>(seen - 2);
+        }
+        return TaggedIndexStack::npos;
+    }
+};
+
+// ===== Treiber 栈 =====
+// 节点池大小固定：push 先从空闲栈取一个节点，写入值后压入数据栈；
+// pop 从数据栈取出节点，读出值后把节点还给空闲栈。节点从不释放，所以无需回收机制。
+template<typename T, bool Elimination = true>
+class TreiberStack {
+private:
+    std::size_t cap;
+    std::unique_ptr<T[]> values;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> links;
+    TaggedIndexStack free_nodes;
+    TaggedIndexStack items;
+    EliminationArray free_arena;
+    EliminationArray item_arena;
+
+    static void push_index(TaggedIndexStack& stack, EliminationArray& arena, std::uint32_t index) {
+        while (!stack.try_push_once(index)) {
+            if constexpr (Elimination) {
+                if (arena.offer_push(index)) return;
+            }
+        }
+    }
+
+    static std::uint32_t pop_index(TaggedIndexStack& stack, EliminationArray& arena) {
+        std::uint32_t index;
+        while (true) {
+            auto r = stack.try_pop_once(index);
+            if (r == TaggedIndexStack::PopResult::Ok) return index;
+            if (r == TaggedIndexStack::PopResult::Empty) return TaggedIndexStack::npos;
+            if constexpr (Elimination) {
+                index = arena.try_take();
+                if (index != TaggedIndexStack::npos) return index;
+            }
+        }
+    }
+
+public:
+    explicit TreiberStack(std::size_t capacity)
+        : cap(capacity),
+          values(new T[capacity]),
+          links(new std::atomic<std::uint32_t>[capacity]),
+          free_nodes(links.get()),
+          items(links.get()) {
+        for (std::size_t i = capacity; i-- > 0;) {
+            free_nodes.push(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    // 节点池耗尽时返回 false
+    bool try_push(T value) {
+        std::uint32_t index = pop_index(free_nodes, free_arena);
+        if (index == TaggedIndexStack::npos) return false;
+        values[index] = std::move(value);
+        push_index(items, item_arena, index);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        std::uint32_t index = pop_index(items, item_arena);
+        if (index == TaggedIndexStack::npos) return false;
+        value = std::move(values[index]);
+        push_index(free_nodes, free_arena, index);
+        return true;
+    }
+
+    std::size_t capacity() const { return cap; }
+    std::uint32_t version() const { return items.version(); }
+};
+
+// 性能对比基线：互斥量保护的 std::stack
+template<typename T>
+class MutexStack {
+private:
+    std::stack<T, std::vector<T>> stack;
+    std::size_t max_size;
+    std::mutex mtx;
+
+public:
+    explicit MutexStack(std::size_t max_sz) : max_size(max_sz) {}
+
+    bool try_push(T value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (stack.size() >= max_size) return false;
+        stack.push(std::move(value));
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (stack.empty()) return false;
+        value = std::move(stack.top());
+        stack.pop();
+        return true;
+    }
+};
+
+void demonstrate_tagged_stack() {
+    std::cout << "\n=== 带版本号的下标栈 ===\n";
+
+    std::vector<std::atomic<std::uint32_t>> links(4);
+    TaggedIndexStack stack(links.data());
+
+    stack.push(0);
+    stack.push(1);
+    std::cout << "压入 0, 1 后版本号: " << stack.version() << "\n";
+
+    std::uint32_t a = stack.pop();
+    std::uint32_t b = stack.pop();
+    stack.push(a);
+    std::cout << "弹出 " << a << ", " << b << " 再压回 " << a
+              << " 后, 栈顶下标相同但版本号变为 " << stack.version() << "\n";
+    std::cout << "因此持有旧快照的线程 CAS 会失败，不会把已弹出的节点 " << b << " 接回栈中\n";
+
+    std::cout << "弹出: " << stack.pop() << ", 再弹出(空栈): "
+              << (stack.pop() == TaggedIndexStack::npos ? "npos" : "?") << "\n";
+}
+
+void demonstrate_treiber_stack() {
+    std::cout << "\n=== 多线程 Treiber 栈 ===\n";
+
+    TreiberStack<long long> stack(1024);
+    const int threads = 4;
+    const int per_thread = 100000;
+    std::atomic<long long> popped_sum{0};
+    std::atomic<int> popped_count{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            long long local_sum = 0;
+            int local_count = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                long long v = static_cast<long long>(t) * per_thread + i;
+                while (!stack.try_push(v)) std::this_thread::yield();
+                long long out;
+                if (stack.try_pop(out)) {
+                    local_sum += out;
+                    ++local_count;
+                }
+            }
+            popped_sum += local_sum;
+            popped_count += local_count;
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    long long rest;
+    long long sum = popped_sum;
+    int count = popped_count;
+    while (stack.try_pop(rest)) {
+        sum += rest;
+        ++count;
+    }
+
+    long long n = static_cast<long long>(threads) * per_thread;
+    std::cout << threads << " 个线程交替 push/pop 共 " << n << " 个元素\n";
+    std::cout << "弹出总数: " << count << ", 总和校验: "
+              << (sum == n * (n - 1) / 2 ? "正确" : "错误") << "\n";
+
+    TreiberStack<std::string> small(2);
+    small.try_push("a");
+    small.try_push("b");
+    std::cout << "容量为 2 的栈压入第 3 个元素: "
+              << (small.try_push("c") ? "成功" : "失败（节点池耗尽）") << "\n";
+}
+
+// 每个线程交替执行 push 和 pop
+template<typename Stack>
+long long measure_stack(int thread_count, int total_pairs, std::size_t capacity) {
+    Stack stack(capacity);
+    for (int i = 0; i < 1000; ++i) stack.try_push(i);  // 预填充，减少空栈
+
+    std::atomic<bool> start{false};
+    int per_thread = total_pairs / thread_count;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&]() {
+            while (!start.load()) std::this_thread::yield();
+            int value;
+            for (int i = 0; i < per_thread; ++i) {
+                stack.try_push(i);
+                stack.try_pop(value);
+            }
+        });
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    start = true;
+    for (auto& t : threads) t.join();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+}
+
+void demonstrate_performance(int total_pairs) {
+    std::cout << "\n=== 性能对比 ===\n";
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency() << "\n";
+
+    const std::size_t capacity = 1 << 16;
+    auto report = [&](const std::string& desc, long long us) {
+        double mops = us > 0 ? 2.0 * total_pairs / us : 0.0;
+        std::cout << "   " << desc << ": " << us << " μs (" << mops << " M ops/s)\n";
+    };
+
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        std::cout << "\n" << threads << " 线程, 共 " << total_pairs << " 对 push/pop:\n";
+        report("MutexStack", measure_stack<MutexStack<int>>(threads, total_pairs, capacity));
+        report("TreiberStack", measure_stack<TreiberStack<int, false>>(threads, total_pairs, capacity));
+        report("TreiberStack+消除", measure_stack<TreiberStack<int, true>>(threads, total_pairs, capacity));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 9: 无锁栈\n";
+    std::cout << "===============================\n";
+
+    demonstrate_tagged_stack();
+    demonstrate_treiber_stack();
+
+    int total_pairs = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    demonstrate_performance(total_pairs);
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
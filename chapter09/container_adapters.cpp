@@ -12,8 +12,9 @@
 #include <list>
 #include <string>
 #include <functional>
+#include <utility>
 
-// 自定义Stack适配器实现
+// 自定义Stack适配器实现（单线程；无锁版本见 concurrent_stack.cpp）
 template<typename T, typename Container = std::deque<T>>
 class MyStack {
 private:
@@ -76,7 +77,7 @@ public:
     }
 };
 
-// 限容队列实现
+// 限容队列实现（单线程；并发版本见 concurrent_queues.cpp）
 template<typename T>
 class BoundedQueue {
 private:
@@ -98,7 +99,7 @@ public:
         if (queue.empty()) {
             return false;  // 队列为空
         }
-        value = queue.front();
+        value = std::move(queue.front());
         queue.pop();
         return true;
     }
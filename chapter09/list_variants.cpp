@@ -0,0 +1,710 @@
+/**
+ * @file list_variants.cpp
+ * @brief 链表变体演示 - 展开链表（UnrolledList）与侵入式双向链表（IntrusiveList）
+ *
+ * list_container.cpp 的 splice/merge/unique/sort 示例和 container_overview.cpp 的
+ * 中间插入测试都基于 std::list，每个 int 都要单独分配一个节点（两个指针 + 数据）。
+ *   - UnrolledList：每个节点存放一小段连续元素，遍历时指针跳转次数减少为 1/B，
+ *     中间插入只移动节点内的少量元素，满了就分裂
+ *   - IntrusiveList：链接指针嵌在元素自身里，容器从不分配内存
+ * 两者都支持 O(1) 的整表 splice。
+ */
+
+#include <iostream>
+#include <list>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <random>
+#include <chrono>
+#include <new>
+
+// ===== 展开链表 =====
+template<typename T, std::size_t NodeCapacity = 64>
+class UnrolledList {
+    static_assert(NodeCapacity >= 2, "节点容量至少为 2");
+
+private:
+    struct Node {
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        std::size_t count = 0;
+        alignas(T) unsigned char storage[NodeCapacity * sizeof(T)];
+
+        T* data() { return reinterpret_cast<T*>(storage); }
+        T& at(std::size_t i) { return data()[i]; }
+    };
+
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    std::size_t total = 0;
+
+    Node* new_node_after(Node* prev) {
+        Node* n = new Node();
+        n->prev = prev;
+        n->next = prev ? prev->next : head;
+        if (n->next) n->next->prev = n; else tail = n;
+        if (prev) prev->next = n; else head = n;
+        return n;
+    }
+
+    void unlink_node(Node* n) {
+        if (n->prev) n->prev->next = n->next; else head = n->next;
+        if (n->next) n->next->prev = n->prev; else tail = n->prev;
+    }
+
+    // 把 n 从 index 开始的后半部分移到新节点，返回新节点
+    Node* split(Node* n, std::size_t index) {
+        Node* m = new_node_after(n);
+        for (std::size_t i = index; i < n->count; ++i) {
+            new (m->data() + (i - index)) T(std::move(n->at(i)));
+            n->at(i).~T();
+        }
+        m->count = n->count - index;
+        n->count = index;
+        return m;
+    }
+
+    // 节点不足半满时尝试与后继合并
+    void maybe_merge(Node* n) {
+        Node* m = n->next;
+        if (!m || n->count + m->count > NodeCapacity / 2 + NodeCapacity / 4) return;
+        for (std::size_t i = 0; i < m->count; ++i) {
+            new (n->data() + n->count + i) T(std::move(m->at(i)));
+            m->at(i).~T();
+        }
+        n->count += m->count;
+        m->count = 0;
+        unlink_node(m);
+        delete m;
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    class iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(Node* n, std::size_t i, const UnrolledList* l) : node(n), index(i), owner(l) {}
+
+        T& operator*() const { return node->at(index); }
+        T* operator->() const { return &node->at(index); }
+
+        iterator& operator++() {
+            if (++index == node->count && node->next) {
+                node = node->next;
+                index = 0;
+            }
+            return *this;
+        }
+        iterator operator++(int) { auto tmp = *this; ++*this; return tmp; }
+
+        iterator& operator--() {
+            if (!node) {  // end() 且链表为空时不会走到这里
+                node = owner->tail;
+                index = node->count;
+            }
+            if (index == 0) {
+                node = node->prev;
+                index = node->count;
+            }
+            --index;
+            return *this;
+        }
+        iterator operator--(int) { auto tmp = *this; --*this; return tmp; }
+
+        bool operator==(const iterator& other) const {
+            return node == other.node && index == other.index;
+        }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class UnrolledList;
+        Node* node = nullptr;
+        std::size_t index = 0;
+        const UnrolledList* owner = nullptr;
+    };
+
+    UnrolledList() = default;
+
+    UnrolledList(std::initializer_list<T> init) {
+        for (const auto& v : init) push_back(v);
+    }
+
+    UnrolledList(const UnrolledList& other) {
+        for (const auto& v : other) push_back(v);
+    }
+
+    UnrolledList(UnrolledList&& other) noexcept
+        : head(other.head), tail(other.tail), total(other.total) {
+        other.head = other.tail = nullptr;
+        other.total = 0;
+    }
+
+    UnrolledList& operator=(UnrolledList other) noexcept {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(total, other.total);
+        return *this;
+    }
+
+    ~UnrolledList() { clear(); }
+
+    bool empty() const { return total == 0; }
+    size_type size() const { return total; }
+    size_type node_count() const {
+        size_type n = 0;
+        for (Node* p = head; p; p = p->next) ++n;
+        return n;
+    }
+
+    // end() 表示为 (tail, tail->count)，这样 insert(end()) 可以直接追加到尾节点
+    iterator begin() const { return head ? iterator(head, 0, this) : end(); }
+    iterator end() const { return iterator(tail, tail ? tail->count : 0, this); }
+
+    // 按下标定位：整节点跳过，只需 O(n / B) 次指针跳转
+    iterator iterator_at(size_type index) const {
+        Node* n = head;
+        while (n && index >= n->count && n->next) {
+            index -= n->count;
+            n = n->next;
+        }
+        return iterator(n, index, this);
+    }
+
+    T& front() { return head->at(0); }
+    T& back() { return tail->at(tail->count - 1); }
+
+    void push_back(const T& value) { insert(end(), value); }
+    void push_front(const T& value) { insert(begin(), value); }
+
+    // 在 pos 之前插入；节点已满时先对半分裂
+    iterator insert(iterator pos, const T& value) {
+        Node* n = pos.node;
+        std::size_t i = pos.index;
+        if (!n) {
+            n = new_node_after(nullptr);
+            i = 0;
+        }
+        if (n->count == NodeCapacity) {
+            std::size_t half = NodeCapacity / 2;
+            Node* m = split(n, half);
+            if (i > half) {
+                n = m;
+                i -= half;
+            }
+        }
+        if (i < n->count) {
+            new (n->data() + n->count) T(std::move(n->at(n->count - 1)));
+            std::move_backward(n->data() + i, n->data() + n->count - 1, n->data() + n->count);
+            n->at(i) = value;
+        } else {
+            new (n->data() + i) T(value);
+        }
+        ++n->count;
+        ++total;
+        return iterator(n, i, this);
+    }
+
+    iterator erase(iterator pos) {
+        Node* n = pos.node;
+        std::size_t i = pos.index;
+        std::move(n->data() + i + 1, n->data() + n->count, n->data() + i);
+        n->at(n->count - 1).~T();
+        --n->count;
+        --total;
+        if (n->count == 0) {
+            Node* next = n->next;
+            unlink_node(n);
+            delete n;
+            return next ? iterator(next, 0, this) : end();
+        }
+        if (n->count < NodeCapacity / 2) maybe_merge(n);
+        if (i >= n->count && n->next) return iterator(n->next, 0, this);
+        return iterator(n, i, this);
+    }
+
+    void clear() {
+        Node* n = head;
+        while (n) {
+            Node* next = n->next;
+            for (std::size_t i = 0; i < n->count; ++i) n->at(i).~T();
+            delete n;
+            n = next;
+        }
+        head = tail = nullptr;
+        total = 0;
+    }
+
+    // 整表拼接：至多分裂 pos 所在节点一次，之后只改链接指针
+    void splice(iterator pos, UnrolledList& other) {
+        if (other.empty() || &other == this) return;
+        Node* before;
+        Node* after;
+        if (!pos.node) {
+            before = nullptr;
+            after = nullptr;
+        } else if (pos.index == 0) {
+            before = pos.node->prev;
+            after = pos.node;
+        } else if (pos.index >= pos.node->count) {
+            before = pos.node;
+            after = pos.node->next;
+        } else {
+            before = pos.node;
+            after = split(pos.node, pos.index);
+        }
+        other.head->prev = before;
+        other.tail->next = after;
+        if (before) before->next = other.head; else head = other.head;
+        if (after) after->prev = other.tail; else tail = other.tail;
+        total += other.total;
+        other.head = other.tail = nullptr;
+        other.total = 0;
+    }
+
+    // 排序与去重：按节点整块收集到连续缓冲区处理，再紧凑地写回
+    template<typename Compare = std::less<T>>
+    void sort(Compare comp = Compare()) {
+        std::vector<T> buffer = drain();
+        std::sort(buffer.begin(), buffer.end(), comp);
+        refill(buffer);
+    }
+
+    template<typename BinaryPred = std::equal_to<T>>
+    void unique(BinaryPred pred = BinaryPred()) {
+        std::vector<T> buffer = drain();
+        buffer.erase(std::unique(buffer.begin(), buffer.end(), pred), buffer.end());
+        refill(buffer);
+    }
+
+    template<typename Compare = std::less<T>>
+    void merge(UnrolledList& other, Compare comp = Compare()) {
+        if (&other == this) return;
+        std::vector<T> a = drain();
+        std::vector<T> b = other.drain();
+        std::vector<T> out;
+        out.reserve(a.size() + b.size());
+        std::merge(std::make_move_iterator(a.begin()), std::make_move_iterator(a.end()),
+                   std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()),
+                   std::back_inserter(out), comp);
+        refill(out);
+    }
+
+private:
+    std::vector<T> drain() {
+        std::vector<T> buffer;
+        buffer.reserve(total);
+        for (Node* n = head; n; n = n->next) {
+            std::move(n->data(), n->data() + n->count, std::back_inserter(buffer));
+        }
+        clear();
+        return buffer;
+    }
+
+    void refill(std::vector<T>& buffer) {
+        for (auto& v : buffer) {
+            if (!tail || tail->count == NodeCapacity) new_node_after(tail);
+            new (tail->data() + tail->count) T(std::move(v));
+            ++tail->count;
+        }
+        total = buffer.size();
+    }
+};
+
+// ===== 侵入式双向链表 =====
+// 元素类型继承 ListHook<Tag>，同一对象可以通过不同 Tag 同时挂在多条链表上。
+// 链表只连接/断开节点，不负责分配和释放。
+template<typename Tag = void>
+struct ListHook {
+    ListHook* prev = nullptr;
+    ListHook* next = nullptr;
+
+    bool is_linked() const { return next != nullptr; }
+};
+
+template<typename T, typename Tag = void>
+class IntrusiveList {
+private:
+    using Hook = ListHook<Tag>;
+
+    Hook sentinel;  // 环形链表的哨兵
+    std::size_t count = 0;
+
+    static T& to_value(Hook* h) { return *static_cast<T*>(h); }
+    static Hook* to_hook(T& value) { return static_cast<Hook*>(&value); }
+
+    static void link_before(Hook* pos, Hook* h) {
+        h->prev = pos->prev;
+        h->next = pos;
+        pos->prev->next = h;
+        pos->prev = h;
+    }
+
+    static void unlink(Hook* h) {
+        h->prev->next = h->next;
+        h->next->prev = h->prev;
+        h->prev = h->next = nullptr;
+    }
+
+    // 把 [first, last] 这段（闭区间）移到 pos 之前
+    static void transfer(Hook* pos, Hook* first, Hook* last) {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+        first->prev = pos->prev;
+        last->next = pos;
+        pos->prev->next = first;
+        pos->prev = last;
+    }
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        explicit iterator(Hook* h) : hook(h) {}
+
+        T& operator*() const { return to_value(hook); }
+        T* operator->() const { return &to_value(hook); }
+        iterator& operator++() { hook = hook->next; return *this; }
+        iterator operator++(int) { auto tmp = *this; hook = hook->next; return tmp; }
+        iterator& operator--() { hook = hook->prev; return *this; }
+        iterator operator--(int) { auto tmp = *this; hook = hook->prev; return tmp; }
+        bool operator==(const iterator& other) const { return hook == other.hook; }
+        bool operator!=(const iterator& other) const { return hook != other.hook; }
+
+    private:
+        friend class IntrusiveList;
+        Hook* hook = nullptr;
+    };
+
+    IntrusiveList() {
+        sentinel.prev = sentinel.next = &sentinel;
+    }
+
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    ~IntrusiveList() { clear(); }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    iterator begin() { return iterator(sentinel.next); }
+    iterator end() { return iterator(&sentinel); }
+
+    // 由元素得到其在链表中的迭代器，O(1)
+    static iterator iterator_to(T& value) { return iterator(to_hook(value)); }
+
+    T& front() { return to_value(sentinel.next); }
+    T& back() { return to_value(sentinel.prev); }
+
+    void push_back(T& value) { insert(end(), value); }
+    void push_front(T& value) { insert(begin(), value); }
+
+    iterator insert(iterator pos, T& value) {
+        link_before(pos.hook, to_hook(value));
+        ++count;
+        return iterator(to_hook(value));
+    }
+
+    iterator erase(iterator pos) {
+        Hook* next = pos.hook->next;
+        unlink(pos.hook);
+        --count;
+        return iterator(next);
+    }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator(sentinel.prev)); }
+
+    void clear() {
+        Hook* h = sentinel.next;
+        while (h != &sentinel) {
+            Hook* next = h->next;
+            h->prev = h->next = nullptr;
+            h = next;
+        }
+        sentinel.prev = sentinel.next = &sentinel;
+        count = 0;
+    }
+
+    // 整表拼接 O(1)
+    void splice(iterator pos, IntrusiveList& other) {
+        if (other.empty() || &other == this) return;
+        transfer(pos.hook, other.sentinel.next, other.sentinel.prev);
+        count += other.count;
+        other.count = 0;
+    }
+
+    // 单元素拼接 O(1)
+    void splice(iterator pos, IntrusiveList& other, iterator it) {
+        transfer(pos.hook, it.hook, it.hook);
+        ++count;
+        --other.count;
+    }
+
+    // 有序合并，只改链接，不分配
+    template<typename Compare = std::less<T>>
+    void merge(IntrusiveList& other, Compare comp = Compare()) {
+        if (&other == this) return;
+        iterator a = begin();
+        while (!other.empty()) {
+            iterator b = other.begin();
+            while (a != end() && !comp(*b, *a)) ++a;
+            splice(a, other, b);
+        }
+    }
+
+    // 自底向上归并排序，O(n log n)，无额外分配
+    template<typename Compare = std::less<T>>
+    void sort(Compare comp = Compare()) {
+        if (count < 2) return;
+        IntrusiveList carry;
+        IntrusiveList buckets[64];
+        int fill = 0;
+        while (!empty()) {
+            carry.splice(carry.begin(), *this, begin());
+            int i = 0;
+            while (i < fill && !buckets[i].empty()) {
+                buckets[i].merge(carry, comp);
+                carry.swap(buckets[i]);
+                ++i;
+            }
+            carry.swap(buckets[i]);
+            if (i == fill) ++fill;
+        }
+        for (int i = 1; i < fill; ++i) buckets[i].merge(buckets[i - 1], comp);
+        swap(buckets[fill - 1]);
+    }
+
+    // 断开连续重复元素（不释放，由调用方管理对象生命周期）
+    template<typename BinaryPred = std::equal_to<T>>
+    std::size_t unique(BinaryPred pred = BinaryPred()) {
+        std::size_t removed = 0;
+        if (count < 2) return removed;
+        iterator prev = begin();
+        iterator cur = std::next(prev);
+        while (cur != end()) {
+            if (pred(*prev, *cur)) {
+                cur = erase(cur);
+                ++removed;
+            } else {
+                prev = cur++;
+            }
+        }
+        return removed;
+    }
+
+    void swap(IntrusiveList& other) {
+        IntrusiveList tmp_holder;
+        tmp_holder.splice(tmp_holder.end(), *this);
+        splice(end(), other);
+        other.splice(other.end(), tmp_holder);
+    }
+};
+
+// 侵入式链表的元素：同时挂在"全部任务"和"就绪任务"两条链表上
+struct AllTag {};
+struct ReadyTag {};
+
+struct Job : ListHook<AllTag>, ListHook<ReadyTag> {
+    int id;
+    int priority;
+    Job(int i = 0, int p = 0) : id(i), priority(p) {}
+    bool operator<(const Job& other) const { return priority < other.priority; }
+    bool operator==(const Job& other) const { return priority == other.priority; }
+};
+
+void demonstrate_unrolled_list() {
+    std::cout << "\n=== 展开链表 ===\n";
+
+    UnrolledList<int, 4> ul{5, 2, 8, 1, 9, 3};
+    std::cout << "初始: ";
+    for (int x : ul) std::cout << x << " ";
+    std::cout << "(节点数 " << ul.node_count() << ")\n";
+
+    ul.insert(ul.iterator_at(3), 100);
+    std::cout << "在下标 3 插入 100: ";
+    for (int x : ul) std::cout << x << " ";
+    std::cout << "\n";
+
+    UnrolledList<int, 4> other{-1, -2};
+    ul.splice(ul.iterator_at(2), other);
+    std::cout << "在下标 2 处 splice {-1, -2}: ";
+    for (int x : ul) std::cout << x << " ";
+    std::cout << "(other 剩余 " << other.size() << ")\n";
+
+    ul.sort();
+    std::cout << "sort(): ";
+    for (int x : ul) std::cout << x << " ";
+    std::cout << "\n";
+
+    UnrolledList<int, 4> dup{1, 1, 2, 2, 2, 3, 1};
+    dup.unique();
+    std::cout << "unique() {1,1,2,2,2,3,1}: ";
+    for (int x : dup) std::cout << x << " ";
+    std::cout << "\n";
+
+    UnrolledList<int, 4> a{1, 3, 5, 7};
+    UnrolledList<int, 4> b{2, 4, 6};
+    a.merge(b);
+    std::cout << "merge {1,3,5,7} + {2,4,6}: ";
+    for (int x : a) std::cout << x << " ";
+    std::cout << "\n";
+}
+
+void demonstrate_intrusive_list() {
+    std::cout << "\n=== 侵入式链表 ===\n";
+
+    std::vector<Job> jobs{{1, 3}, {2, 1}, {3, 2}, {4, 3}, {5, 1}};
+    IntrusiveList<Job, AllTag> all_jobs;
+    IntrusiveList<Job, ReadyTag> ready;
+
+    for (auto& job : jobs) all_jobs.push_back(job);
+    ready.push_back(jobs[1]);
+    ready.push_back(jobs[3]);
+
+    std::cout << "全部任务: ";
+    for (const auto& job : all_jobs) std::cout << "J" << job.id << "(P" << job.priority << ") ";
+    std::cout << "\n就绪任务: ";
+    for (const auto& job : ready) std::cout << "J" << job.id << " ";
+    std::cout << "\n";
+
+    // 同一对象在另一条链表中的位置可 O(1) 取得并删除
+    ready.erase(IntrusiveList<Job, ReadyTag>::iterator_to(jobs[1]));
+    std::cout << "从就绪链表移除 J2 后, 就绪数: " << ready.size()
+              << ", 全部任务数: " << all_jobs.size() << "\n";
+
+    all_jobs.sort();
+    std::cout << "按优先级 sort(): ";
+    for (const auto& job : all_jobs) std::cout << "J" << job.id << "(P" << job.priority << ") ";
+    std::cout << "\n";
+
+    std::size_t removed = all_jobs.unique();
+    std::cout << "unique() 断开 " << removed << " 个同优先级任务: ";
+    for (const auto& job : all_jobs) std::cout << "J" << job.id << " ";
+    std::cout << "\n";
+
+    std::vector<Job> extra{{10, 0}, {11, 5}};
+    IntrusiveList<Job, AllTag> extra_list;
+    for (auto& job : extra) extra_list.push_back(job);
+    all_jobs.merge(extra_list);
+    std::cout << "merge 新任务后: ";
+    for (const auto& job : all_jobs) std::cout << "J" << job.id << "(P" << job.priority << ") ";
+    std::cout << "\n";
+
+    all_jobs.clear();
+    ready.clear();
+}
+
+struct IntNode : ListHook<> {
+    int value;
+    explicit IntNode(int v = 0) : value(v) {}
+};
+
+void demonstrate_performance() {
+    std::cout << "\n=== 性能对比 ===\n";
+
+    auto measure_time = [](auto func, const std::string& desc) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << desc << ": " << duration.count() << " μs\n";
+    };
+
+    const int N = 100000;
+    const int INSERTS = 10000;
+    std::mt19937 gen(42);
+    std::vector<int> positions(INSERTS);
+    for (int i = 0; i < INSERTS; ++i) positions[i] = static_cast<int>(gen() % (N + i));
+    long long check = 0;
+
+    std::cout << "\n随机位置插入 " << INSERTS << " 次 (初始 " << N << " 个元素, 含定位):\n";
+    measure_time([&]() {
+        std::list<int> lst(N, 1);
+        for (int i = 0; i < INSERTS; ++i) lst.insert(std::next(lst.begin(), positions[i]), i);
+        check += lst.size();
+    }, "std::list");
+    measure_time([&]() {
+        UnrolledList<int, 64> ul;
+        for (int i = 0; i < N; ++i) ul.push_back(1);
+        for (int i = 0; i < INSERTS; ++i) ul.insert(ul.iterator_at(positions[i]), i);
+        check += ul.size();
+    }, "UnrolledList<64>");
+    measure_time([&]() {
+        std::vector<IntNode> pool(N + INSERTS);
+        IntrusiveList<IntNode> il;
+        for (int i = 0; i < N; ++i) il.push_back(pool[i]);
+        for (int i = 0; i < INSERTS; ++i) {
+            pool[N + i].value = i;
+            il.insert(std::next(il.begin(), positions[i]), pool[N + i]);
+        }
+        check += il.size();
+        il.clear();
+    }, "IntrusiveList (预分配对象)");
+
+    const int M = 2000000;
+    std::cout << "\n构建 " << M << " 个元素的链表:\n";
+    std::list<int> lst;
+    UnrolledList<int, 64> ul;
+    std::vector<IntNode> pool(M);
+    IntrusiveList<IntNode> il;
+    measure_time([&]() { for (int i = 0; i < M; ++i) lst.push_back(i); }, "std::list push_back");
+    measure_time([&]() { for (int i = 0; i < M; ++i) ul.push_back(i); }, "UnrolledList push_back");
+    measure_time([&]() {
+        for (int i = 0; i < M; ++i) {
+            pool[i].value = i;
+            il.push_back(pool[i]);
+        }
+    }, "IntrusiveList push_back (零分配)");
+
+    std::cout << "\n顺序遍历求和:\n";
+    measure_time([&]() { for (int x : lst) check += x; }, "std::list");
+    measure_time([&]() { for (int x : ul) check += x; }, "UnrolledList");
+    measure_time([&]() { for (const auto& n : il) check += n.value; }, "IntrusiveList");
+
+    std::cout << "\n整表 splice:\n";
+    measure_time([&]() {
+        std::list<int> other(1000, 7);
+        lst.splice(std::next(lst.begin(), 10), other);
+        check += lst.size();
+    }, "std::list");
+    measure_time([&]() {
+        UnrolledList<int, 64> other;
+        for (int i = 0; i < 1000; ++i) other.push_back(7);
+        ul.splice(ul.iterator_at(10), other);
+        check += ul.size();
+    }, "UnrolledList");
+
+    il.clear();
+    std::cout << "   (校验值: " << check << ")\n";
+}
+
+int main() {
+    std::cout << "C++ Primer Chapter 9: 链表变体\n";
+    std::cout << "===============================\n";
+
+    demonstrate_unrolled_list();
+    demonstrate_intrusive_list();
+    demonstrate_performance();
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
@@ -0,0 +1,644 @@
+/**
+ * @file priority_queues.cpp
+ * @brief 优先队列实现演示 - d 叉堆、基数堆、索引堆（decrease_key）、配对堆
+ *
+ * container_adapters.cpp 中的 MyPriorityQueue 是基于 push_heap/pop_heap 的二叉堆。
+ * 本文件沿用相同的适配器接口（empty/size/top/push/pop），给出四种更适合调度器的实现，
+ * 并在百万节点的随机图上用 Dijkstra 最短路做性能对比。
+ * 用法: ./priority_queues [节点数]   (默认 1000000，平均出度 5)
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+#include <cstdlib>
+#include <cassert>
+
+// ===== d 叉堆 =====
+// 每个节点有 D 个孩子，树高为 log_D(n)；D=4/8 时一个节点的孩子落在同一两条缓存行内，
+// sift_down 比较次数略多但缓存缺失更少。Compare 语义与 std::priority_queue 相同
+template<typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class DaryHeap {
+    static_assert(D >= 2, "DaryHeap 至少需要 2 叉");
+
+private:
+    std::vector<T> container;
+    Compare comp;
+
+    void sift_up(std::size_t i) {
+        T value = std::move(container[i]);
+        while (i > 0) {
+            std::size_t parent = (i - 1) / D;
+            if (!comp(container[parent], value)) break;
+            container[i] = std::move(container[parent]);
+            i = parent;
+        }
+        container[i] = std::move(value);
+    }
+
+    void sift_down(std::size_t i) {
+        std::size_t n = container.size();
+        T value = std::move(container[i]);
+        for (;;) {
+            std::size_t first = i * D + 1;
+            if (first >= n) break;
+            std::size_t last = std::min(first + D, n);
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; ++c) {
+                if (comp(container[best], container[c])) best = c;
+            }
+            if (!comp(value, container[best])) break;
+            container[i] = std::move(container[best]);
+            i = best;
+        }
+        container[i] = std::move(value);
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    DaryHeap() = default;
+    explicit DaryHeap(const Compare& compare) : comp(compare) {}
+
+    bool empty() const { return container.empty(); }
+    size_type size() const { return container.size(); }
+    void reserve(size_type n) { container.reserve(n); }
+
+    const value_type& top() const {
+        return container.front();
+    }
+
+    void push(const value_type& value) {
+        container.push_back(value);
+        sift_up(container.size() - 1);
+    }
+
+    void pop() {
+        container.front() = std::move(container.back());
+        container.pop_back();
+        if (!container.empty()) sift_down(0);
+    }
+};
+
+// ===== 单调基数堆 =====
+// 仅适用于无符号整数键，且每次插入的键不小于最近一次弹出的键（Dijkstra 满足）。
+// 键按与 last 的最高不同位分桶，均摊 O(log C) 每次操作，C 为键范围
+template<typename Value, typename Key = std::uint64_t>
+class RadixHeap {
+    static_assert(std::is_unsigned<Key>::value, "RadixHeap 的键必须是无符号整数");
+
+public:
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+
+private:
+    static constexpr int kBits = std::numeric_limits<Key>::digits;
+
+    mutable std::vector<value_type> buckets[kBits + 1];
+    mutable Key last = 0;
+    size_type count = 0;
+
+    static int bucket_index(Key key, Key base) {
+        Key diff = key ^ base;
+        if (diff == 0) return 0;
+        return 64 - __builtin_clzll(static_cast<unsigned long long>(diff));
+    }
+
+    // 桶 0 为空时，把第一个非空桶的最小键作为新的 last 并重新分桶
+    void refill() const {
+        if (!buckets[0].empty()) return;
+        int i = 1;
+        while (buckets[i].empty()) ++i;
+        Key new_last = buckets[i].front().first;
+        for (const auto& item : buckets[i]) new_last = std::min(new_last, item.first);
+        last = new_last;
+        for (auto& item : buckets[i]) {
+            buckets[bucket_index(item.first, last)].push_back(std::move(item));
+        }
+        buckets[i].clear();
+    }
+
+public:
+    bool empty() const { return count == 0; }
+    size_type size() const { return count; }
+
+    const value_type& top() const {
+        refill();
+        return buckets[0].back();
+    }
+
+    void push(const value_type& value) {
+        assert(value.first >= last && "RadixHeap 要求键单调不减");
+        buckets[bucket_index(value.first, last)].push_back(value);
+        ++count;
+    }
+
+    void pop() {
+        refill();
+        buckets[0].pop_back();
+        --count;
+    }
+};
+
+// ===== 索引 d 叉堆 =====
+// 元素由 [0, capacity) 的 id 标识，pos 数组记录 id 在堆中的位置，
+// 因此可以 O(log n) 地 decrease_key，而不必插入重复元素（惰性删除）
+template<typename Key, std::size_t D = 4, typename Compare = std::greater<Key>>
+class IndexedHeap {
+public:
+    using value_type = std::pair<std::size_t, Key>;  // (id, key)
+    using size_type = std::size_t;
+
+private:
+    static constexpr std::size_t kNotInHeap = static_cast<std::size_t>(-1);
+
+    std::vector<std::size_t> heap;  // 堆中存 id
+    std::vector<std::size_t> pos;   // id -> 堆中位置
+    std::vector<Key> keys;          // id -> 键
+    Compare comp;
+
+    // 与 std::priority_queue 一致：comp(a, b) 为真表示 a 的优先级低于 b
+    bool lower(std::size_t a, std::size_t b) const { return comp(keys[a], keys[b]); }
+
+    void place(std::size_t i, std::size_t id) {
+        heap[i] = id;
+        pos[id] = i;
+    }
+
+    void sift_up(std::size_t i) {
+        std::size_t id = heap[i];
+        while (i > 0) {
+            std::size_t parent = (i - 1) / D;
+            if (!lower(heap[parent], id)) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, id);
+    }
+
+    void sift_down(std::size_t i) {
+        std::size_t n = heap.size();
+        std::size_t id = heap[i];
+        for (;;) {
+            std::size_t first = i * D + 1;
+            if (first >= n) break;
+            std::size_t last = std::min(first + D, n);
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; ++c) {
+                if (lower(heap[best], heap[c])) best = c;
+            }
+            if (!lower(id, heap[best])) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, id);
+    }
+
+public:
+    explicit IndexedHeap(std::size_t capacity, const Compare& compare = Compare())
+        : pos(capacity, kNotInHeap), keys(capacity), comp(compare) {}
+
+    bool empty() const { return heap.empty(); }
+    size_type size() const { return heap.size(); }
+    bool contains(std::size_t id) const { return pos[id] != kNotInHeap; }
+
+    value_type top() const {
+        return {heap.front(), keys[heap.front()]};
+    }
+
+    void push(const value_type& value) {
+        std::size_t id = value.first;
+        keys[id] = value.second;
+        heap.push_back(id);
+        pos[id] = heap.size() - 1;
+        sift_up(heap.size() - 1);
+    }
+
+    void pop() {
+        std::size_t id = heap.front();
+        pos[id] = kNotInHeap;
+        std::size_t back = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(0, back);
+            sift_down(0);
+        }
+    }
+
+    // 提高 id 的优先级（对最小堆即减小键）
+    void decrease_key(std::size_t id, const Key& key) {
+        keys[id] = key;
+        sift_up(pos[id]);
+    }
+
+    // 不在堆中则插入，否则在新键更优时 decrease_key；返回是否有改动
+    bool push_or_decrease(std::size_t id, const Key& key) {
+        if (!contains(id)) {
+            push({id, key});
+            return true;
+        }
+        if (comp(keys[id], key)) {
+            decrease_key(id, key);
+            return true;
+        }
+        return false;
+    }
+};
+
+// ===== 配对堆 =====
+// 多叉树 + 两遍合并；push 与 decrease_key 为 O(1)，pop 均摊 O(log n)。
+// 节点存放在 vector 中并用下标链接，pop 出的节点进入空闲链表复用
+template<typename T, typename Compare = std::less<T>>
+class PairingHeap {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using handle_type = std::uint32_t;
+
+private:
+    static constexpr handle_type kNull = static_cast<handle_type>(-1);
+
+    struct Node {
+        T value;
+        handle_type child = kNull;
+        handle_type sibling = kNull;  // 右兄弟（空闲节点复用为 next）
+        handle_type prev = kNull;     // 左兄弟或父节点
+    };
+
+    std::vector<Node> nodes;
+    std::vector<handle_type> pairing_buffer;
+    handle_type root = kNull;
+    handle_type free_list = kNull;
+    size_type count = 0;
+    Compare comp;
+
+    // 合并两棵树，返回新根；优先级低的一方成为另一方的第一个孩子
+    handle_type meld(handle_type a, handle_type b) {
+        if (a == kNull) return b;
+        if (b == kNull) return a;
+        if (comp(nodes[a].value, nodes[b].value)) std::swap(a, b);
+        nodes[b].prev = a;
+        nodes[b].sibling = nodes[a].child;
+        if (nodes[a].child != kNull) nodes[nodes[a].child].prev = b;
+        nodes[a].child = b;
+        nodes[a].sibling = kNull;
+        nodes[a].prev = kNull;
+        return a;
+    }
+
+    // 两遍合并：从左到右两两合并，再从右到左依次合并
+    handle_type merge_pairs(handle_type first) {
+        pairing_buffer.clear();
+        while (first != kNull) {
+            handle_type a = first;
+            handle_type b = nodes[a].sibling;
+            first = b != kNull ? nodes[b].sibling : kNull;
+            nodes[a].sibling = nodes[a].prev = kNull;
+            if (b != kNull) nodes[b].sibling = nodes[b].prev = kNull;
+            pairing_buffer.push_back(meld(a, b));
+        }
+        handle_type result = kNull;
+        for (auto it = pairing_buffer.rbegin(); it != pairing_buffer.rend(); ++it) {
+            result = meld(*it, result);
+        }
+        return result;
+    }
+
+    // 把子树 h 从其父节点/兄弟链中摘下
+    void detach(handle_type h) {
+        Node& n = nodes[h];
+        if (nodes[n.prev].child == h) {
+            nodes[n.prev].child = n.sibling;
+        } else {
+            nodes[n.prev].sibling = n.sibling;
+        }
+        if (n.sibling != kNull) nodes[n.sibling].prev = n.prev;
+        n.sibling = n.prev = kNull;
+    }
+
+public:
+    PairingHeap() = default;
+    explicit PairingHeap(const Compare& compare) : comp(compare) {}
+
+    bool empty() const { return count == 0; }
+    size_type size() const { return count; }
+    void reserve(size_type n) { nodes.reserve(n); }
+
+    const value_type& top() const {
+        return nodes[root].value;
+    }
+
+    const value_type& value(handle_type h) const {
+        return nodes[h].value;
+    }
+
+    handle_type push(const value_type& value) {
+        handle_type h;
+        if (free_list != kNull) {
+            h = free_list;
+            free_list = nodes[h].sibling;
+            nodes[h] = Node{value};
+        } else {
+            h = static_cast<handle_type>(nodes.size());
+            nodes.push_back(Node{value});
+        }
+        root = meld(root, h);
+        ++count;
+        return h;
+    }
+
+    void pop() {
+        handle_type old_root = root;
+        root = merge_pairs(nodes[old_root].child);
+        nodes[old_root].child = kNull;
+        nodes[old_root].sibling = free_list;
+        free_list = old_root;
+        --count;
+    }
+
+    // 提高节点优先级：摘下子树后与根合并
+    void decrease_key(handle_type h, const value_type& value) {
+        nodes[h].value = value;
+        if (h == root) return;
+        detach(h);
+        root = meld(root, h);
+    }
+};
+
+void demonstrate_dary_heap() {
+    std::cout << "\n=== d 叉堆 ===\n";
+
+    DaryHeap<int, 4> max_heap;
+    DaryHeap<int, 8, std::greater<int>> min_heap;
+    std::vector<int> nums = {3, 1, 4, 1, 5, 9, 2, 6};
+    for (auto num : nums) {
+        max_heap.push(num);
+        min_heap.push(num);
+    }
+
+    std::cout << "4 叉大顶堆出队: ";
+    while (!max_heap.empty()) {
+        std::cout << max_heap.top() << " ";
+        max_heap.pop();
+    }
+    std::cout << "\n8 叉小顶堆出队: ";
+    while (!min_heap.empty()) {
+        std::cout << min_heap.top() << " ";
+        min_heap.pop();
+    }
+    std::cout << "\n";
+}
+
+void demonstrate_radix_heap() {
+    std::cout << "\n=== 单调基数堆 ===\n";
+
+    RadixHeap<std::string> heap;
+    heap.push({30, "任务C"});
+    heap.push({10, "任务A"});
+    heap.push({20, "任务B"});
+
+    std::cout << "出队: ";
+    auto item = heap.top();
+    heap.pop();
+    std::cout << item.second << "(" << item.first << ") ";
+
+    // 新插入的键只要不小于已弹出的键即可
+    heap.push({15, "任务D"});
+    while (!heap.empty()) {
+        item = heap.top();
+        std::cout << item.second << "(" << item.first << ") ";
+        heap.pop();
+    }
+    std::cout << "\n";
+}
+
+void demonstrate_indexed_heap() {
+    std::cout << "\n=== 索引堆与 decrease_key ===\n";
+
+    IndexedHeap<int> heap(5);  // 默认 std::greater，小顶堆
+    heap.push({0, 50});
+    heap.push({1, 40});
+    heap.push({2, 30});
+    std::cout << "初始堆顶: id=" << heap.top().first << ", key=" << heap.top().second << "\n";
+
+    heap.decrease_key(0, 10);
+    std::cout << "decrease_key(0, 10) 后堆顶: id=" << heap.top().first
+              << ", key=" << heap.top().second << "\n";
+
+    std::cout << "push_or_decrease(1, 45) 生效: " << std::boolalpha
+              << heap.push_or_decrease(1, 45) << "\n";
+
+    std::cout << "出队: ";
+    while (!heap.empty()) {
+        std::cout << "(" << heap.top().first << "," << heap.top().second << ") ";
+        heap.pop();
+    }
+    std::cout << "\n";
+}
+
+void demonstrate_pairing_heap() {
+    std::cout << "\n=== 配对堆 ===\n";
+
+    PairingHeap<int, std::greater<int>> heap;
+    auto h1 = heap.push(42);
+    heap.push(17);
+    auto h3 = heap.push(99);
+    heap.push(8);
+
+    heap.decrease_key(h3, 1);
+    heap.decrease_key(h1, 5);
+
+    std::cout << "decrease_key(99->1, 42->5) 后出队: ";
+    while (!heap.empty()) {
+        std::cout << heap.top() << " ";
+        heap.pop();
+    }
+    std::cout << "\n";
+}
+
+// ===== Dijkstra 性能测试 =====
+struct Graph {
+    std::vector<std::uint32_t> offsets;  // CSR 格式
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint32_t> weights;
+
+    std::size_t node_count() const { return offsets.size() - 1; }
+};
+
+Graph make_random_graph(std::size_t nodes, std::size_t degree, std::uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<std::uint32_t> node_dist(0, static_cast<std::uint32_t>(nodes - 1));
+    std::uniform_int_distribution<std::uint32_t> weight_dist(1, 1000);
+
+    Graph g;
+    g.offsets.resize(nodes + 1);
+    g.targets.reserve(nodes * (degree + 1));
+    g.weights.reserve(nodes * (degree + 1));
+    for (std::size_t u = 0; u < nodes; ++u) {
+        g.offsets[u] = static_cast<std::uint32_t>(g.targets.size());
+        // 一条到后继的边保证连通
+        g.targets.push_back(static_cast<std::uint32_t>((u + 1) % nodes));
+        g.weights.push_back(weight_dist(gen));
+        for (std::size_t e = 0; e < degree; ++e) {
+            g.targets.push_back(node_dist(gen));
+            g.weights.push_back(weight_dist(gen));
+        }
+    }
+    g.offsets[nodes] = static_cast<std::uint32_t>(g.targets.size());
+    return g;
+}
+
+using Dist = std::uint64_t;
+using DistNode = std::pair<Dist, std::uint32_t>;
+constexpr Dist kInfinity = std::numeric_limits<Dist>::max();
+
+// 惰性删除版本：允许堆中有重复节点，弹出时跳过过期项
+template<typename Heap>
+std::vector<Dist> dijkstra_lazy(const Graph& g, Heap& heap) {
+    std::vector<Dist> dist(g.node_count(), kInfinity);
+    dist[0] = 0;
+    heap.push({0, 0});
+    while (!heap.empty()) {
+        auto [d, u] = heap.top();
+        heap.pop();
+        if (d != dist[u]) continue;
+        for (std::uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            std::uint32_t v = g.targets[e];
+            Dist nd = d + g.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push({nd, v});
+            }
+        }
+    }
+    return dist;
+}
+
+std::vector<Dist> dijkstra_indexed(const Graph& g) {
+    std::vector<Dist> dist(g.node_count(), kInfinity);
+    IndexedHeap<Dist, 4> heap(g.node_count());
+    dist[0] = 0;
+    heap.push({0, 0});
+    while (!heap.empty()) {
+        auto [u, d] = heap.top();
+        heap.pop();
+        for (std::uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            std::uint32_t v = g.targets[e];
+            Dist nd = d + g.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push_or_decrease(v, nd);
+            }
+        }
+    }
+    return dist;
+}
+
+std::vector<Dist> dijkstra_pairing(const Graph& g) {
+    using Heap = PairingHeap<DistNode, std::greater<DistNode>>;
+    std::vector<Dist> dist(g.node_count(), kInfinity);
+    std::vector<Heap::handle_type> handle(g.node_count(), static_cast<Heap::handle_type>(-1));
+    std::vector<char> done(g.node_count(), 0);
+    Heap heap;
+    dist[0] = 0;
+    handle[0] = heap.push({0, 0});
+    while (!heap.empty()) {
+        auto [d, u] = heap.top();
+        heap.pop();
+        done[u] = 1;
+        for (std::uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            std::uint32_t v = g.targets[e];
+            Dist nd = d + g.weights[e];
+            if (nd < dist[v]) {
+                bool in_heap = dist[v] != kInfinity && !done[v];
+                dist[v] = nd;
+                if (in_heap) {
+                    heap.decrease_key(handle[v], {nd, v});
+                } else {
+                    handle[v] = heap.push({nd, v});
+                }
+            }
+        }
+    }
+    return dist;
+}
+
+// 基数堆的 value_type 是 (键, 值)，与 DistNode 布局一致
+struct RadixAdapter {
+    RadixHeap<std::uint32_t> heap;
+    bool empty() const { return heap.empty(); }
+    DistNode top() const { return heap.top(); }
+    void push(const DistNode& item) { heap.push(item); }
+    void pop() { heap.pop(); }
+};
+
+void demonstrate_performance(std::size_t nodes) {
+    std::cout << "\n=== Dijkstra 性能对比 (节点数 = " << nodes << ", 平均出度 5) ===\n";
+
+    Graph g = make_random_graph(nodes, 4, 42);
+    std::cout << "边数: " << g.targets.size() << "\n";
+
+    std::vector<Dist> reference;
+    auto run = [&](const std::string& desc, auto solver) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<Dist> dist = solver();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        if (reference.empty()) reference = dist;
+        std::cout << "   " << desc << ": " << ms << " ms"
+                  << (dist == reference ? "" : "  [结果不一致!]") << "\n";
+    };
+
+    run("std::priority_queue (二叉堆)", [&]() {
+        std::priority_queue<DistNode, std::vector<DistNode>, std::greater<DistNode>> heap;
+        return dijkstra_lazy(g, heap);
+    });
+    run("DaryHeap<4>", [&]() {
+        DaryHeap<DistNode, 4, std::greater<DistNode>> heap;
+        return dijkstra_lazy(g, heap);
+    });
+    run("DaryHeap<8>", [&]() {
+        DaryHeap<DistNode, 8, std::greater<DistNode>> heap;
+        return dijkstra_lazy(g, heap);
+    });
+    run("RadixHeap", [&]() {
+        RadixAdapter heap;
+        return dijkstra_lazy(g, heap);
+    });
+    run("IndexedHeap<4> (decrease_key)", [&]() {
+        return dijkstra_indexed(g);
+    });
+    run("PairingHeap (decrease_key)", [&]() {
+        return dijkstra_pairing(g);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 9: 优先队列实现\n";
+    std::cout << "===============================\n";
+
+    std::size_t nodes = 1000000;
+    if (argc > 1) {
+        nodes = std::strtoull(argv[1], nullptr, 10);
+        if (nodes < 2) nodes = 1000000;
+    }
+
+    demonstrate_dary_heap();
+    demonstrate_radix_heap();
+    demonstrate_indexed_heap();
+    demonstrate_pairing_heap();
+    demonstrate_performance(nodes);
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
@@ -0,0 +1,450 @@
+/**
+ * @file segmented_vector.cpp
+ * @brief 分段向量演示 - 可配置块大小、移位/掩码索引、双端增长、元素地址稳定
+ *
+ * deque_container.cpp 中测试了 std::deque 的 push_front 与随机访问。libstdc++ 的 deque
+ * 固定使用 512 字节的块，大元素时每块只能放一两个，索引也需要除法。
+ * SegmentedVector 的块大小是 2 的幂（按元素个数配置），索引只需移位和掩码；
+ * 块一旦分配就不再移动，因此两端增长都不会使已有元素的地址失效。
+ * 用法: ./segmented_vector [元素个数]   (默认 2000000)
+ */
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <stdexcept>
+#include <chrono>
+#include <string>
+#include <random>
+#include <cstdlib>
+
+template<typename T, std::size_t ChunkSize = 1024>
+class SegmentedVector {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                  "ChunkSize 必须是 2 的幂");
+
+private:
+    static constexpr std::size_t kShift = __builtin_ctzll(ChunkSize);
+    static constexpr std::size_t kMask = ChunkSize - 1;
+
+    // 块表：块指针可以为空（尚未分配）。head 是第 0 个元素在块表覆盖范围中的绝对位置
+    std::vector<T*> chunks;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    std::allocator<T> alloc;
+
+    T* slot(std::size_t absolute) const {
+        return chunks[absolute >> kShift] + (absolute & kMask);
+    }
+
+    T* ensure_chunk(std::size_t chunk_index) {
+        T*& chunk = chunks[chunk_index];
+        if (!chunk) chunk = alloc.allocate(ChunkSize);
+        return chunk;
+    }
+
+    void free_chunk(std::size_t chunk_index) {
+        if (chunks[chunk_index]) {
+            alloc.deallocate(chunks[chunk_index], ChunkSize);
+            chunks[chunk_index] = nullptr;
+        }
+    }
+
+    // 把在用的块放到块表中间，两端都留出空位；只移动块指针，不移动元素。
+    // 块表至少一半空闲时就地把在用的块挪到中间（队列式的 push_back/pop_front 不会让块表无限增长），
+    // 否则分配两倍大小的新块表
+    void grow_map() {
+        std::size_t first = head >> kShift;
+        std::size_t last = std::min(chunks.size(), ((head + count) >> kShift) + 1);
+        std::size_t used = last - first;
+
+        // 在用范围之外的块都是空块，先归还
+        for (std::size_t i = 0; i < first; ++i) free_chunk(i);
+        for (std::size_t i = last; i < chunks.size(); ++i) free_chunk(i);
+
+        std::size_t new_first;
+        if (chunks.size() >= 2 * used + 2) {
+            new_first = (chunks.size() - used) / 2;
+            if (new_first < first) {
+                std::copy(chunks.begin() + first, chunks.begin() + last, chunks.begin() + new_first);
+            } else {
+                std::copy_backward(chunks.begin() + first, chunks.begin() + last, chunks.begin() + new_first + used);
+            }
+            std::fill(chunks.begin(), chunks.begin() + new_first, nullptr);
+            std::fill(chunks.begin() + new_first + used, chunks.end(), nullptr);
+        } else {
+            std::size_t new_size = std::max<std::size_t>({chunks.size() * 2, 2 * used + 2, 4});
+            std::vector<T*> new_chunks(new_size, nullptr);
+            new_first = (new_size - used) / 2;
+            std::copy(chunks.begin() + first, chunks.begin() + last, new_chunks.begin() + new_first);
+            chunks.swap(new_chunks);
+        }
+        head = head - first * ChunkSize + new_first * ChunkSize;
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    template<bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using container = std::conditional_t<Const, const SegmentedVector, SegmentedVector>;
+
+        basic_iterator() = default;
+        basic_iterator(container* c, std::size_t i) : owner(c), index(i) {}
+        operator basic_iterator<true>() const { return {owner, index}; }
+
+        reference operator*() const { return (*owner)[index]; }
+        pointer operator->() const { return &(*owner)[index]; }
+        reference operator[](difference_type n) const { return (*owner)[index + n]; }
+
+        basic_iterator& operator++() { ++index; return *this; }
+        basic_iterator operator++(int) { auto tmp = *this; ++index; return tmp; }
+        basic_iterator& operator--() { --index; return *this; }
+        basic_iterator operator--(int) { auto tmp = *this; --index; return tmp; }
+        basic_iterator& operator+=(difference_type n) { index += n; return *this; }
+        basic_iterator& operator-=(difference_type n) { index -= n; return *this; }
+        basic_iterator operator+(difference_type n) const { return {owner, index + n}; }
+        basic_iterator operator-(difference_type n) const { return {owner, index - n}; }
+        difference_type operator-(const basic_iterator& other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const basic_iterator& other) const { return index == other.index; }
+        bool operator!=(const basic_iterator& other) const { return index != other.index; }
+        bool operator<(const basic_iterator& other) const { return index < other.index; }
+        bool operator>(const basic_iterator& other) const { return index > other.index; }
+        bool operator<=(const basic_iterator& other) const { return index <= other.index; }
+        bool operator>=(const basic_iterator& other) const { return index >= other.index; }
+
+    private:
+        container* owner = nullptr;
+        std::size_t index = 0;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    static constexpr size_type chunk_size() { return ChunkSize; }
+
+    SegmentedVector() = default;
+
+    SegmentedVector(const SegmentedVector& other) {
+        for (const auto& value : other) push_back(value);
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : chunks(std::move(other.chunks)), head(other.head), count(other.count) {
+        other.chunks.clear();
+        other.head = 0;
+        other.count = 0;
+    }
+
+    SegmentedVector& operator=(SegmentedVector other) noexcept {
+        chunks.swap(other.chunks);
+        std::swap(head, other.head);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        clear();
+        for (std::size_t i = 0; i < chunks.size(); ++i) free_chunk(i);
+    }
+
+    bool empty() const { return count == 0; }
+    size_type size() const { return count; }
+
+    // O(1) 索引：一次移位取块、一次掩码取块内偏移
+    reference operator[](size_type i) { return *slot(head + i); }
+    const_reference operator[](size_type i) const { return *slot(head + i); }
+
+    reference at(size_type i) {
+        if (i >= count) throw std::out_of_range("SegmentedVector::at");
+        return (*this)[i];
+    }
+
+    const_reference at(size_type i) const {
+        if (i >= count) throw std::out_of_range("SegmentedVector::at");
+        return (*this)[i];
+    }
+
+    reference front() { return (*this)[0]; }
+    reference back() { return (*this)[count - 1]; }
+    const_reference front() const { return (*this)[0]; }
+    const_reference back() const { return (*this)[count - 1]; }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, count}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, count}; }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (((head + count) >> kShift) >= chunks.size()) grow_map();
+        std::size_t pos = head + count;  // grow_map 可能移动 head
+        T* p = ensure_chunk(pos >> kShift) + (pos & kMask);
+        new (p) T(std::forward<Args>(args)...);
+        ++count;
+        return *p;
+    }
+
+    template<typename... Args>
+    reference emplace_front(Args&&... args) {
+        if (head == 0) grow_map();
+        std::size_t pos = head - 1;
+        T* p = ensure_chunk(pos >> kShift) + (pos & kMask);
+        new (p) T(std::forward<Args>(args)...);
+        --head;
+        ++count;
+        return *p;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    // 弹出时若某块已完全空出，则归还该块
+    void pop_back() {
+        std::size_t pos = head + count - 1;
+        slot(pos)->~T();
+        --count;
+        if ((pos & kMask) == 0) free_chunk(pos >> kShift);
+    }
+
+    void pop_front() {
+        slot(head)->~T();
+        ++head;
+        --count;
+        if ((head & kMask) == 0) free_chunk((head >> kShift) - 1);
+    }
+
+    void clear() {
+        while (count > 0) pop_back();
+    }
+
+    size_type map_size() const { return chunks.size(); }
+
+    size_type chunk_count() const {
+        return count == 0 ? 0 : ((head + count - 1) >> kShift) - (head >> kShift) + 1;
+    }
+
+    // 按块访问连续内存：func(T* first, T* last)
+    template<typename Func>
+    void for_each_chunk(Func func) {
+        if (count == 0) return;
+        std::size_t first = head;
+        std::size_t last = head + count;
+        while (first < last) {
+            std::size_t chunk_end = std::min(last, (first | kMask) + 1);
+            T* base = slot(first);
+            func(base, base + (chunk_end - first));
+            first = chunk_end;
+        }
+    }
+
+    // 把块均分给多个线程，每个线程只处理自己的连续内存段
+    template<typename Func>
+    void parallel_for_each_chunk(Func func, unsigned threads = std::thread::hardware_concurrency()) {
+        if (count == 0) return;
+        threads = std::max(1u, threads);
+        std::size_t first_chunk = head >> kShift;
+        std::size_t total_chunks = chunk_count();
+        std::size_t per_thread = (total_chunks + threads - 1) / threads;
+
+        auto work = [&](std::size_t c_begin, std::size_t c_end) {
+            for (std::size_t c = c_begin; c < c_end; ++c) {
+                std::size_t lo = std::max(head, c << kShift);
+                std::size_t hi = std::min(head + count, (c + 1) << kShift);
+                func(slot(lo), slot(lo) + (hi - lo));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t c = first_chunk + per_thread; c < first_chunk + total_chunks; c += per_thread) {
+            workers.emplace_back(work, c, std::min(c + per_thread, first_chunk + total_chunks));
+        }
+        work(first_chunk, std::min(first_chunk + per_thread, first_chunk + total_chunks));
+        for (auto& t : workers) t.join();
+    }
+};
+
+void demonstrate_basic_operations() {
+    std::cout << "\n=== 分段向量基本操作 ===\n";
+
+    SegmentedVector<int, 4> sv;  // 演示用的小块
+    for (int i = 1; i <= 6; ++i) sv.push_back(i);
+    for (int i = 0; i >= -3; --i) sv.push_front(i);
+
+    std::cout << "内容: ";
+    for (int x : sv) std::cout << x << " ";
+    std::cout << "\nsize: " << sv.size() << ", 块大小: " << sv.chunk_size()
+              << ", 占用块数: " << sv.chunk_count() << "\n";
+    std::cout << "sv[0] = " << sv[0] << ", sv[9] = " << sv[9] << "\n";
+
+    sv.pop_front();
+    sv.pop_back();
+    std::cout << "pop_front + pop_back 后: ";
+    for (int x : sv) std::cout << x << " ";
+    std::cout << "\n";
+
+    // 与标准算法配合
+    std::sort(sv.begin(), sv.end(), std::greater<int>());
+    std::cout << "降序排序: ";
+    for (int x : sv) std::cout << x << " ";
+    std::cout << "\n";
+
+    // 当作队列使用：块表在空闲过半时就地居中，大小保持有界
+    SegmentedVector<int, 4> queue;
+    for (int i = 0; i < 16; ++i) queue.push_back(i);
+    std::size_t map_before = queue.map_size();
+    for (int i = 16; i < 1000000; ++i) {
+        queue.push_back(i);
+        queue.pop_front();
+    }
+    std::cout << "队列 push_back/pop_front 一百万次: 块表大小 " << map_before << " -> " << queue.map_size()
+              << ", 队首 " << queue.front() << "\n";
+}
+
+void demonstrate_stable_addresses() {
+    std::cout << "\n=== 元素地址稳定性 ===\n";
+
+    SegmentedVector<std::string, 8> sv;
+    sv.push_back("anchor");
+    const std::string* anchor = &sv[0];
+
+    for (int i = 0; i < 1000; ++i) {
+        sv.push_back("back" + std::to_string(i));
+        sv.push_front("front" + std::to_string(i));
+    }
+
+    std::cout << "两端各插入 1000 个元素后，原地址处的值: " << *anchor << "\n";
+    std::cout << "地址仍然有效: " << std::boolalpha << (anchor == &sv[1000]) << "\n";
+
+    std::vector<std::string> vec{"anchor"};
+    const std::string* vec_anchor = &vec[0];
+    for (int i = 0; i < 1000; ++i) vec.push_back("x");
+    std::cout << "对比 vector 扩容后地址是否变化: " << (vec_anchor != &vec[0]) << "\n";
+}
+
+void demonstrate_chunk_iteration() {
+    std::cout << "\n=== 按块迭代与并行处理 ===\n";
+
+    SegmentedVector<long long, 1024> sv;
+    for (int i = 1; i <= 100000; ++i) sv.push_back(i);
+
+    long long serial_sum = 0;
+    std::size_t chunks_seen = 0;
+    sv.for_each_chunk([&](long long* first, long long* last) {
+        serial_sum = std::accumulate(first, last, serial_sum);
+        ++chunks_seen;
+    });
+    std::cout << "for_each_chunk: " << chunks_seen << " 个块, 总和 " << serial_sum << "\n";
+
+    sv.parallel_for_each_chunk([](long long* first, long long* last) {
+        for (auto* p = first; p != last; ++p) *p *= 2;
+    }, 4);
+    std::cout << "parallel_for_each_chunk (4 线程) 每个元素乘 2 后: sv[0] = " << sv[0]
+              << ", sv.back() = " << sv.back() << "\n";
+}
+
+struct LargeElement {
+    char payload[256];
+    long long key;
+    explicit LargeElement(long long k = 0) : key(k) { payload[0] = static_cast<char>(k); }
+};
+
+template<typename T>
+void run_benchmark(const std::string& title, std::size_t n) {
+    std::cout << "\n" << title << " (n = " << n << ", sizeof = " << sizeof(T) << "):\n";
+
+    auto measure_time = [](auto func, const std::string& desc) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << desc << ": " << duration.count() << " μs\n";
+    };
+
+    std::vector<std::size_t> indices(n);
+    std::mt19937 gen(1);
+    for (auto& i : indices) i = gen() % n;
+    long long check = 0;
+
+    SegmentedVector<T, 1024> sv;
+    std::deque<T> dq;
+    std::vector<T> vec;
+
+    measure_time([&]() { for (std::size_t i = 0; i < n; ++i) sv.emplace_back(i); }, "SegmentedVector push_back");
+    measure_time([&]() { for (std::size_t i = 0; i < n; ++i) dq.emplace_back(i); }, "deque push_back");
+    measure_time([&]() { for (std::size_t i = 0; i < n; ++i) vec.emplace_back(i); }, "vector push_back");
+
+    measure_time([&]() {
+        SegmentedVector<T, 1024> front;
+        for (std::size_t i = 0; i < n; ++i) front.emplace_front(i);
+        check += front.size();
+    }, "SegmentedVector push_front");
+    measure_time([&]() {
+        std::deque<T> front;
+        for (std::size_t i = 0; i < n; ++i) front.emplace_front(i);
+        check += front.size();
+    }, "deque push_front");
+
+    auto key_of = [](const auto& x) -> long long {
+        if constexpr (std::is_arithmetic<std::decay_t<decltype(x)>>::value) return x;
+        else return x.key;
+    };
+
+    measure_time([&]() { for (auto i : indices) check += key_of(sv[i]); }, "SegmentedVector 随机访问");
+    measure_time([&]() { for (auto i : indices) check += key_of(dq[i]); }, "deque 随机访问");
+    measure_time([&]() { for (auto i : indices) check += key_of(vec[i]); }, "vector 随机访问");
+
+    measure_time([&]() {
+        sv.for_each_chunk([&](T* first, T* last) {
+            for (auto* p = first; p != last; ++p) check += key_of(*p);
+        });
+    }, "SegmentedVector 按块遍历");
+    measure_time([&]() { for (const auto& x : dq) check += key_of(x); }, "deque 遍历");
+    measure_time([&]() { for (const auto& x : vec) check += key_of(x); }, "vector 遍历");
+
+    std::cout << "   (校验值: " << check << ")\n";
+}
+
+void demonstrate_performance(std::size_t n) {
+    std::cout << "\n=== 性能对比 ===\n";
+    run_benchmark<long long>("小元素", n);
+    run_benchmark<LargeElement>("大元素", n / 4);
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 9: 分段向量\n";
+    std::cout << "===============================\n";
+
+    std::size_t n = 2000000;
+    if (argc > 1) {
+        n = std::strtoull(argv[1], nullptr, 10);
+        if (n == 0) n = 2000000;
+    }
+
+    demonstrate_basic_operations();
+    demonstrate_stable_addresses();
+    demonstrate_chunk_iteration();
+    demonstrate_performance(n);
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
@@ -25,7 +25,7 @@ void demonstrate_accumulate() {
     int product = std::accumulate(numbers.begin(), numbers.end(), 1, std::multiplies<int>());
     std::cout << "product: " << product << "\n";
     
-    // 字符串连接
+    // 字符串连接（每一步都会拷贝累加器，大量片段时是 O(n²)，见 string_builder.cpp 中的 join）
     std::vector<std::string> words{"Hello", " ", "World", "!"};
     std::string sentence = std::accumulate(words.begin(), words.end(), std::string(""));
     std::cout << "连接字符串: \"" << sentence << "\"\n";
@@ -0,0 +1,500 @@
+/**
+ * @file parallel_numeric.cpp
+ * @brief 并行数值内核演示 - 多线程 reduce/scan、SIMD 点积、融合 transform_reduce
+ *
+ * numeric_algorithms.cpp 中的 accumulate、inner_product、partial_sum 都是串行实现，
+ * 本文件给出对应的并行/向量化版本，并与标准算法做性能对比。
+ * 用法: ./parallel_numeric [元素个数]   (默认 1M，可放大到 1B，注意内存占用)
+ */
+
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace numeric_kernels {
+
+// 每个线程至少处理的元素数，避免小数据量时线程开销大于计算本身
+constexpr std::size_t kMinGrain = 1 << 16;
+
+inline unsigned thread_count_for(std::size_t n) {
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t by_grain = std::max<std::size_t>(1, n / kMinGrain);
+    return static_cast<unsigned>(std::min<std::size_t>(hw, by_grain));
+}
+
+// 把 [0, n) 均分为 parts 块，对每块调用 func(block_index, begin, end)
+// 第 0 块在调用线程上执行，其余块各起一个线程
+template<typename Func>
+void for_each_block(std::size_t n, unsigned parts, Func func) {
+    std::vector<std::thread> workers;
+    workers.reserve(parts > 0 ? parts - 1 : 0);
+    std::size_t chunk = n / parts;
+    std::size_t rem = n % parts;
+    std::size_t begin = 0;
+    std::size_t first_end = 0;
+    for (unsigned b = 0; b < parts; ++b) {
+        std::size_t end = begin + chunk + (b < rem ? 1 : 0);
+        if (b == 0) {
+            first_end = end;
+        } else {
+            workers.emplace_back(func, b, begin, end);
+        }
+        begin = end;
+    }
+    func(0u, std::size_t{0}, first_end);
+    for (auto& t : workers) t.join();
+}
+
+// ===== 并行归约 =====
+// op 需满足结合律；各块的部分结果按块顺序合并，结果与串行一致（整数）
+template<typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp{}) {
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    unsigned parts = thread_count_for(n);
+    if (parts <= 1) {
+        return std::accumulate(first, last, init, op);
+    }
+
+    std::vector<T> partial(parts);
+    for_each_block(n, parts, [&](unsigned b, std::size_t lo, std::size_t hi) {
+        T acc = *(first + lo);
+        for (std::size_t i = lo + 1; i < hi; ++i) acc = op(acc, *(first + i));
+        partial[b] = acc;
+    });
+    for (const auto& p : partial) init = op(init, p);
+    return init;
+}
+
+// ===== 并行扫描（两遍分块算法）=====
+// 第一遍：各块独立求块内总和；中间：对块总和做串行前缀；第二遍：各块带偏移量扫描
+// inclusive 扫描不使用 init（与 std::inclusive_scan 一致），第 0 块没有进位
+template<typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt blocked_scan(InputIt first, InputIt last, OutputIt d_first,
+                      T init, BinaryOp op, bool inclusive) {
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    if (n == 0) return d_first;
+    unsigned parts = thread_count_for(n);
+
+    auto scan_block = [&](std::size_t lo, std::size_t hi, const T* carry_in) {
+        std::size_t i = lo;
+        T carry;
+        if (carry_in) {
+            carry = *carry_in;
+        } else {
+            carry = *(first + i);
+            *(d_first + i) = carry;
+            ++i;
+        }
+        for (; i < hi; ++i) {
+            T next = op(carry, *(first + i));
+            *(d_first + i) = inclusive ? next : carry;
+            carry = next;
+        }
+    };
+
+    if (parts <= 1) {
+        scan_block(0, n, inclusive ? nullptr : &init);
+        return d_first + n;
+    }
+
+    // 第一遍
+    std::vector<T> block_sum(parts);
+    for_each_block(n, parts, [&](unsigned b, std::size_t lo, std::size_t hi) {
+        T acc = *(first + lo);
+        for (std::size_t i = lo + 1; i < hi; ++i) acc = op(acc, *(first + i));
+        block_sum[b] = acc;
+    });
+
+    // 块偏移量（块数很少，串行即可）
+    std::vector<T> offset(parts);
+    T running = inclusive ? block_sum[0] : op(init, block_sum[0]);
+    offset[0] = init;
+    for (unsigned b = 1; b < parts; ++b) {
+        offset[b] = running;
+        running = op(running, block_sum[b]);
+    }
+
+    // 第二遍
+    for_each_block(n, parts, [&](unsigned b, std::size_t lo, std::size_t hi) {
+        scan_block(lo, hi, (inclusive && b == 0) ? nullptr : &offset[b]);
+    });
+    return d_first + n;
+}
+
+template<typename InputIt, typename OutputIt, typename BinaryOp = std::plus<>>
+OutputIt parallel_inclusive_scan(InputIt first, InputIt last, OutputIt d_first,
+                                 BinaryOp op = BinaryOp{}) {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    return blocked_scan(first, last, d_first, T{}, op, true);
+}
+
+template<typename InputIt, typename OutputIt, typename T, typename BinaryOp = std::plus<>>
+OutputIt parallel_exclusive_scan(InputIt first, InputIt last, OutputIt d_first,
+                                 T init, BinaryOp op = BinaryOp{}) {
+    return blocked_scan(first, last, d_first, init, op, false);
+}
+
+// ===== 融合 transform_reduce =====
+// 一次遍历完成"逐元素变换 + 归约"，不生成中间数组
+template<typename RandomIt, typename T, typename ReduceOp, typename TransformOp>
+T parallel_transform_reduce(RandomIt first, RandomIt last, T init,
+                            ReduceOp reduce, TransformOp transform) {
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    unsigned parts = thread_count_for(n);
+    std::vector<T> partial(parts, T{});
+    std::vector<char> has_value(parts, 0);
+    for_each_block(n, parts, [&](unsigned b, std::size_t lo, std::size_t hi) {
+        if (lo == hi) return;
+        T acc = transform(*(first + lo));
+        for (std::size_t i = lo + 1; i < hi; ++i) acc = reduce(acc, transform(*(first + i)));
+        partial[b] = acc;
+        has_value[b] = 1;
+    });
+    for (unsigned b = 0; b < parts; ++b) {
+        if (has_value[b]) init = reduce(init, partial[b]);
+    }
+    return init;
+}
+
+template<typename RandomIt1, typename RandomIt2, typename T,
+         typename ReduceOp, typename TransformOp>
+T parallel_transform_reduce(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, T init,
+                            ReduceOp reduce, TransformOp transform) {
+    std::size_t n = static_cast<std::size_t>(std::distance(first1, last1));
+    unsigned parts = thread_count_for(n);
+    std::vector<T> partial(parts, T{});
+    std::vector<char> has_value(parts, 0);
+    for_each_block(n, parts, [&](unsigned b, std::size_t lo, std::size_t hi) {
+        if (lo == hi) return;
+        T acc = transform(*(first1 + lo), *(first2 + lo));
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            acc = reduce(acc, transform(*(first1 + i), *(first2 + i)));
+        }
+        partial[b] = acc;
+        has_value[b] = 1;
+    });
+    for (unsigned b = 0; b < parts; ++b) {
+        if (has_value[b]) init = reduce(init, partial[b]);
+    }
+    return init;
+}
+
+// ===== SIMD 点积 =====
+enum class Summation {
+    Naive,     // 直接累加（最快，误差随 n 线性增长）
+    Kahan,     // Kahan 补偿求和（误差与 n 无关）
+    Pairwise   // 成对求和（误差 O(log n)）
+};
+
+namespace detail {
+
+#if defined(__SSE2__)
+inline float hsum(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+#endif
+
+// 直接累加：4 路 SIMD × 2 个累加器，打破依赖链
+inline float dot_naive(const float* a, const float* b, std::size_t n) {
+    std::size_t i = 0;
+    float result = 0.0f;
+#if defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    result = hsum(_mm_add_ps(acc0, acc1));
+#endif
+    for (; i < n; ++i) result += a[i] * b[i];
+    return result;
+}
+
+// Kahan 求和：每条 SIMD 通道维护自己的补偿项
+// 注意：不能用 -ffast-math 编译，否则补偿项会被优化掉
+inline float dot_kahan(const float* a, const float* b, std::size_t n) {
+    std::size_t i = 0;
+    float sum = 0.0f;
+    float c = 0.0f;
+#if defined(__SSE2__)
+    __m128 vsum = _mm_setzero_ps();
+    __m128 vc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        __m128 y = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), vc);
+        __m128 t = _mm_add_ps(vsum, y);
+        vc = _mm_sub_ps(_mm_sub_ps(t, vsum), y);
+        vsum = t;
+    }
+    alignas(16) float lanes[4];
+    alignas(16) float comps[4];
+    _mm_store_ps(lanes, vsum);
+    _mm_store_ps(comps, vc);
+    for (int k = 0; k < 4; ++k) {
+        float y = lanes[k] - c;
+        float t = sum + y;
+        c = (t - sum) - y;
+        sum = t;
+        y = -comps[k] - c;
+        t = sum + y;
+        c = (t - sum) - y;
+        sum = t;
+    }
+#endif
+    for (; i < n; ++i) {
+        float y = a[i] * b[i] - c;
+        float t = sum + y;
+        c = (t - sum) - y;
+        sum = t;
+    }
+    return sum;
+}
+
+// 成对求和：递归二分，叶子块用 SIMD 直接累加
+inline float dot_pairwise(const float* a, const float* b, std::size_t n) {
+    constexpr std::size_t kLeaf = 256;
+    if (n <= kLeaf) return dot_naive(a, b, n);
+    std::size_t half = (n / 2 + 7) & ~std::size_t{7};
+    return dot_pairwise(a, b, half) + dot_pairwise(a + half, b + half, n - half);
+}
+
+inline float dot_serial(const float* a, const float* b, std::size_t n, Summation mode) {
+    switch (mode) {
+        case Summation::Kahan:    return dot_kahan(a, b, n);
+        case Summation::Pairwise: return dot_pairwise(a, b, n);
+        case Summation::Naive:
+        default:                  return dot_naive(a, b, n);
+    }
+}
+
+} // namespace detail
+
+// 多线程 + SIMD 点积；块间部分和用 double 合并
+inline float simd_dot(const float* a, const float* b, std::size_t n,
+                      Summation mode = Summation::Pairwise) {
+    unsigned parts = thread_count_for(n);
+    if (parts <= 1) return detail::dot_serial(a, b, n, mode);
+
+    std::vector<double> partial(parts);
+    for_each_block(n, parts, [&](unsigned blk, std::size_t lo, std::size_t hi) {
+        partial[blk] = detail::dot_serial(a + lo, b + lo, hi - lo, mode);
+    });
+    double total = 0.0;
+    for (double p : partial) total += p;
+    return static_cast<float>(total);
+}
+
+} // namespace numeric_kernels
+
+void demonstrate_parallel_reduce() {
+    std::cout << "\n=== 并行 reduce ===\n";
+
+    std::vector<long long> numbers(1000000);
+    std::iota(numbers.begin(), numbers.end(), 1);
+
+    long long serial = std::accumulate(numbers.begin(), numbers.end(), 0LL);
+    long long parallel = numeric_kernels::parallel_reduce(numbers.begin(), numbers.end(), 0LL);
+    std::cout << "1..1000000 求和 (accumulate): " << serial << "\n";
+    std::cout << "1..1000000 求和 (parallel_reduce): " << parallel << "\n";
+
+    std::vector<int> small{3, 9, 2, 7};
+    int max_value = numeric_kernels::parallel_reduce(small.begin(), small.end(), 0,
+        [](int a, int b) { return std::max(a, b); });
+    std::cout << "最大值 (自定义 op): " << max_value << "\n";
+}
+
+void demonstrate_parallel_scan() {
+    std::cout << "\n=== 并行 inclusive/exclusive scan ===\n";
+
+    std::vector<int> numbers{1, 2, 3, 4, 5};
+    std::vector<int> inclusive(numbers.size());
+    std::vector<int> exclusive(numbers.size());
+
+    numeric_kernels::parallel_inclusive_scan(numbers.begin(), numbers.end(), inclusive.begin());
+    numeric_kernels::parallel_exclusive_scan(numbers.begin(), numbers.end(), exclusive.begin(), 0);
+
+    std::cout << "原数据: ";
+    for (auto x : numbers) std::cout << x << " ";
+    std::cout << "\ninclusive_scan: ";
+    for (auto x : inclusive) std::cout << x << " ";
+    std::cout << "\nexclusive_scan: ";
+    for (auto x : exclusive) std::cout << x << " ";
+    std::cout << "\n";
+
+    // 大数据量时走两遍分块路径，结果应与 partial_sum 一致
+    std::vector<long long> big(1 << 20);
+    std::iota(big.begin(), big.end(), 0);
+    std::vector<long long> expected(big.size());
+    std::vector<long long> actual(big.size());
+    std::partial_sum(big.begin(), big.end(), expected.begin());
+    numeric_kernels::parallel_inclusive_scan(big.begin(), big.end(), actual.begin());
+    std::cout << "1M 元素分块扫描与 partial_sum 一致: " << std::boolalpha
+              << (expected == actual) << "\n";
+}
+
+void demonstrate_simd_dot() {
+    std::cout << "\n=== SIMD 点积与求和精度 ===\n";
+
+    // 大量小数累加，直接累加会明显丢失精度
+    const std::size_t n = 10000000;
+    std::vector<float> a(n, 0.1f);
+    std::vector<float> b(n, 1.0f);
+    double exact = 0.1f * static_cast<double>(n);
+
+    using numeric_kernels::Summation;
+    float naive = numeric_kernels::detail::dot_serial(a.data(), b.data(), n, Summation::Naive);
+    float kahan = numeric_kernels::detail::dot_serial(a.data(), b.data(), n, Summation::Kahan);
+    float pairwise = numeric_kernels::detail::dot_serial(a.data(), b.data(), n, Summation::Pairwise);
+    float serial = std::inner_product(a.begin(), a.end(), b.begin(), 0.0f);
+
+    std::cout << std::fixed;
+    std::cout << "精确值:           " << exact << "\n";
+    std::cout << "inner_product:    " << serial << "\n";
+    std::cout << "SIMD Naive:       " << naive << "\n";
+    std::cout << "SIMD Kahan:       " << kahan << "\n";
+    std::cout << "SIMD Pairwise:    " << pairwise << "\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+void demonstrate_transform_reduce() {
+    std::cout << "\n=== 融合 transform_reduce ===\n";
+
+    std::vector<double> values{1.0, 2.0, 3.0, 4.0};
+    // 平方和：变换与归约在同一次遍历中完成
+    double sum_sq = numeric_kernels::parallel_transform_reduce(values.begin(), values.end(), 0.0,
+        std::plus<>(), [](double x) { return x * x; });
+    std::cout << "平方和: " << sum_sq << "\n";
+
+    std::vector<int> v1{1, 2, 3, 4};
+    std::vector<int> v2{5, 6, 7, 8};
+    // 二元形式等价于 inner_product
+    int dot = numeric_kernels::parallel_transform_reduce(v1.begin(), v1.end(), v2.begin(), 0,
+        std::plus<>(), std::multiplies<>());
+    std::cout << "内积: " << dot << "\n";
+}
+
+void demonstrate_performance(std::size_t n) {
+    std::cout << "\n=== 性能对比 (n = " << n << ", 线程数 = "
+              << numeric_kernels::thread_count_for(n) << ") ===\n";
+
+    auto measure_time = [](auto func, const std::string& desc) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << desc << ": " << duration.count() << " μs\n";
+        return duration.count();
+    };
+
+    std::vector<long long> data(n);
+    std::iota(data.begin(), data.end(), 0);
+    long long sink = 0;
+
+    std::cout << "\n归约:\n";
+    auto t_acc = measure_time([&]() {
+        sink += std::accumulate(data.begin(), data.end(), 0LL);
+    }, "std::accumulate");
+    auto t_red = measure_time([&]() {
+        sink += numeric_kernels::parallel_reduce(data.begin(), data.end(), 0LL);
+    }, "parallel_reduce");
+    std::cout << "   加速比: " << static_cast<double>(t_acc) / std::max<long long>(1, t_red) << "x\n";
+
+    std::cout << "\n扫描:\n";
+    std::vector<long long> out(n);
+    auto t_ps = measure_time([&]() {
+        std::partial_sum(data.begin(), data.end(), out.begin());
+    }, "std::partial_sum");
+    auto t_scan = measure_time([&]() {
+        numeric_kernels::parallel_inclusive_scan(data.begin(), data.end(), out.begin());
+    }, "parallel_inclusive_scan");
+    std::cout << "   加速比: " << static_cast<double>(t_ps) / std::max<long long>(1, t_scan) << "x\n";
+    sink += out.back();
+    out.clear();
+    out.shrink_to_fit();
+    data.clear();
+    data.shrink_to_fit();
+
+    std::cout << "\n点积 (float):\n";
+    std::vector<float> a(n), b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<float>(i % 100) * 0.01f;
+        b[i] = static_cast<float>(i % 7) * 0.5f;
+    }
+    float fsink = 0.0f;
+    auto t_ip = measure_time([&]() {
+        fsink += std::inner_product(a.begin(), a.end(), b.begin(), 0.0f);
+    }, "std::inner_product");
+    using numeric_kernels::Summation;
+    auto t_naive = measure_time([&]() {
+        fsink += numeric_kernels::simd_dot(a.data(), b.data(), n, Summation::Naive);
+    }, "simd_dot (Naive)");
+    measure_time([&]() {
+        fsink += numeric_kernels::simd_dot(a.data(), b.data(), n, Summation::Pairwise);
+    }, "simd_dot (Pairwise)");
+    measure_time([&]() {
+        fsink += numeric_kernels::simd_dot(a.data(), b.data(), n, Summation::Kahan);
+    }, "simd_dot (Kahan)");
+    std::cout << "   Naive 加速比: " << static_cast<double>(t_ip) / std::max<long long>(1, t_naive) << "x\n";
+
+    std::cout << "\ntransform_reduce (平方和):\n";
+    double dsink = 0.0;
+    auto t_sep = measure_time([&]() {
+        std::vector<float> squares(n);
+        std::transform(a.begin(), a.end(), squares.begin(), [](float x) { return x * x; });
+        dsink += std::accumulate(squares.begin(), squares.end(), 0.0);
+    }, "transform + accumulate (两遍)");
+    measure_time([&]() {
+        dsink += std::transform_reduce(a.begin(), a.end(), 0.0, std::plus<>(),
+                                       [](float x) { return static_cast<double>(x) * x; });
+    }, "std::transform_reduce");
+    auto t_fused = measure_time([&]() {
+        dsink += numeric_kernels::parallel_transform_reduce(a.begin(), a.end(), 0.0, std::plus<>(),
+            [](float x) { return static_cast<double>(x) * x; });
+    }, "parallel_transform_reduce");
+    std::cout << "   融合加速比: " << static_cast<double>(t_sep) / std::max<long long>(1, t_fused) << "x\n";
+
+    // 防止结果被优化掉
+    std::cout << "\n(校验值: " << sink << ", " << fsink << ", " << dsink << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 10: 并行数值内核演示\n";
+    std::cout << "================================\n";
+
+    std::size_t n = 1000000;
+    if (argc > 1) {
+        n = std::strtoull(argv[1], nullptr, 10);
+        if (n == 0) n = 1000000;
+    }
+
+    try {
+        demonstrate_parallel_reduce();
+        demonstrate_parallel_scan();
+        demonstrate_simd_dot();
+        demonstrate_transform_reduce();
+        demonstrate_performance(n);
+
+    } catch (const std::exception& e) {
+        std::cerr << "异常: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
@@ -0,0 +1,529 @@
+/**
+ * @file string_builder.cpp
+ * @brief 字符串拼接演示 - join 算法、预分配的 StringBuilder、无拷贝的 Rope
+ *
+ * numeric_algorithms.cpp 中 accumulate 拼接字符串时，每一步都会拷贝整个累加器，
+ * 总开销是 O(n²)。本文件给出三种替代方案并做性能对比：
+ *   - join：两遍扫描，先求总长度再一次性分配
+ *   - StringBuilder：记录片段视图（临时字符串移入自有存储），str() 时单次分配、顺序拷贝
+ *   - Rope：平衡树结构，append/insert/substr 都不拷贝字符数据
+ * 用法: ./string_builder [片段个数]   (默认 1M)
+ */
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+
+// ===== join 算法 =====
+// 第一遍累计长度，第二遍拷贝；要求前向迭代器（需要遍历两次）
+template<typename ForwardIt>
+std::string join(ForwardIt first, ForwardIt last, std::string_view separator = "") {
+    if (first == last) return std::string();
+
+    std::size_t total = 0;
+    std::size_t count = 0;
+    for (auto it = first; it != last; ++it, ++count) {
+        total += std::string_view(*it).size();
+    }
+    total += separator.size() * (count - 1);
+
+    std::string result;
+    result.resize(total);
+    char* out = result.data();
+    for (auto it = first; it != last; ++it) {
+        if (it != first) {
+            std::memcpy(out, separator.data(), separator.size());
+            out += separator.size();
+        }
+        std::string_view piece(*it);
+        std::memcpy(out, piece.data(), piece.size());
+        out += piece.size();
+    }
+    return result;
+}
+
+template<typename Range>
+std::string join(const Range& range, std::string_view separator = "") {
+    return join(std::begin(range), std::end(range), separator);
+}
+
+// ===== StringBuilder =====
+// 左值字符串只记录视图，不拷贝；str() 时按总长度一次分配。
+// 临时 std::string（如 to_string(i)、a + b）会被移入 owned 保存，视图指向这份副本。
+// 注意：以 string_view / const char* 传入的片段不会被保存，其字符必须在 str() 调用之前保持有效
+class StringBuilder {
+private:
+    std::vector<std::string_view> parts;
+    std::deque<std::string> owned;  // deque 追加时不移动已有元素，视图保持有效
+    std::size_t total_length = 0;
+
+public:
+    StringBuilder() = default;
+    explicit StringBuilder(std::size_t expected_parts) {
+        parts.reserve(expected_parts);
+    }
+
+    // 拷贝后的视图仍会指向原对象的 owned；移动 deque 不搬动元素，视图保持有效
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+    StringBuilder(StringBuilder&&) = default;
+    StringBuilder& operator=(StringBuilder&&) = default;
+
+    StringBuilder& append(std::string_view piece) {
+        parts.push_back(piece);
+        total_length += piece.size();
+        return *this;
+    }
+
+    StringBuilder& append(const char* piece) {
+        return append(std::string_view(piece));
+    }
+
+    StringBuilder& append(const std::string& piece) {
+        return append(std::string_view(piece));
+    }
+
+    StringBuilder& append(std::string&& piece) {
+        owned.push_back(std::move(piece));
+        return append(std::string_view(owned.back()));
+    }
+
+    template<typename Piece>
+    StringBuilder& operator<<(Piece&& piece) {
+        return append(std::forward<Piece>(piece));
+    }
+
+    std::size_t length() const { return total_length; }
+    std::size_t part_count() const { return parts.size(); }
+
+    void clear() {
+        parts.clear();
+        owned.clear();
+        total_length = 0;
+    }
+
+    std::string str() const {
+        std::string result;
+        result.resize(total_length);
+        char* out = result.data();
+        for (auto piece : parts) {
+            std::memcpy(out, piece.data(), piece.size());
+            out += piece.size();
+        }
+        return result;
+    }
+};
+
+// ===== Rope =====
+// 不可变的 AVL 平衡二叉树：叶子共享底层字符缓冲区（偏移 + 长度），
+// 内部节点只记录左右子树；修改操作通过路径复制生成新树，旧版本仍然有效
+class Rope {
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        std::size_t length;
+        int height;                              // 叶子为 0
+        std::shared_ptr<const std::string> text; // 仅叶子使用
+        std::size_t offset;                      // 叶子在 text 中的起始位置
+        NodePtr left, right;                     // 仅内部节点使用
+
+        bool is_leaf() const { return !left; }
+        std::string_view view() const {
+            return std::string_view(*text).substr(offset, length);
+        }
+    };
+
+    // 小片段追加时合并到最右叶子，避免百万级小叶子节点
+    static constexpr std::size_t kSmallLeaf = 128;
+
+    NodePtr root;
+
+    explicit Rope(NodePtr node) : root(std::move(node)) {}
+
+    static int height(const NodePtr& n) { return n ? n->height : -1; }
+    static std::size_t length(const NodePtr& n) { return n ? n->length : 0; }
+
+    static NodePtr make_leaf(std::shared_ptr<const std::string> text,
+                             std::size_t offset, std::size_t len) {
+        if (len == 0) return nullptr;
+        auto node = std::make_shared<Node>();
+        node->length = len;
+        node->height = 0;
+        node->text = std::move(text);
+        node->offset = offset;
+        return node;
+    }
+
+    static NodePtr make_node(NodePtr l, NodePtr r) {
+        auto node = std::make_shared<Node>();
+        node->length = l->length + r->length;
+        node->height = std::max(l->height, r->height) + 1;
+        node->offset = 0;
+        node->left = std::move(l);
+        node->right = std::move(r);
+        return node;
+    }
+
+    static NodePtr rotate_left(const NodePtr& n) {
+        return make_node(make_node(n->left, n->right->left), n->right->right);
+    }
+
+    static NodePtr rotate_right(const NodePtr& n) {
+        return make_node(n->left->left, make_node(n->left->right, n->right));
+    }
+
+    // 高度相差超过 1 时沿较高一侧的边下降，再用旋转恢复平衡（AVL join）
+    static NodePtr join_right(const NodePtr& l, const NodePtr& r) {
+        const NodePtr& ll = l->left;
+        const NodePtr& c = l->right;
+        if (height(c) <= height(r) + 1) {
+            NodePtr t = make_node(c, r);
+            if (height(t) <= height(ll) + 1) return make_node(ll, t);
+            return rotate_left(make_node(ll, rotate_right(t)));
+        }
+        NodePtr t = join_right(c, r);
+        NodePtr result = make_node(ll, t);
+        if (height(t) <= height(ll) + 1) return result;
+        return rotate_left(result);
+    }
+
+    static NodePtr join_left(const NodePtr& l, const NodePtr& r) {
+        const NodePtr& c = r->left;
+        const NodePtr& rr = r->right;
+        if (height(c) <= height(l) + 1) {
+            NodePtr t = make_node(l, c);
+            if (height(t) <= height(rr) + 1) return make_node(t, rr);
+            return rotate_right(make_node(rotate_left(t), rr));
+        }
+        NodePtr t = join_left(l, c);
+        NodePtr result = make_node(t, rr);
+        if (height(t) <= height(rr) + 1) return result;
+        return rotate_right(result);
+    }
+
+    static NodePtr join(const NodePtr& l, const NodePtr& r) {
+        if (!l) return r;
+        if (!r) return l;
+        if (l->height > r->height + 1) return join_right(l, r);
+        if (r->height > l->height + 1) return join_left(l, r);
+        return make_node(l, r);
+    }
+
+    // 在 pos 处切成两棵树；叶子被切开时两半共享同一缓冲区
+    static std::pair<NodePtr, NodePtr> split(const NodePtr& n, std::size_t pos) {
+        if (!n) return {nullptr, nullptr};
+        if (pos == 0) return {nullptr, n};
+        if (pos >= n->length) return {n, nullptr};
+        if (n->is_leaf()) {
+            return {make_leaf(n->text, n->offset, pos),
+                    make_leaf(n->text, n->offset + pos, n->length - pos)};
+        }
+        std::size_t left_len = n->left->length;
+        if (pos < left_len) {
+            auto parts = split(n->left, pos);
+            return {parts.first, join(parts.second, n->right)};
+        }
+        if (pos == left_len) return {n->left, n->right};
+        auto parts = split(n->right, pos - left_len);
+        return {join(n->left, parts.first), parts.second};
+    }
+
+    // 把小片段并入最右叶子；最右叶子过大时返回 nullptr
+    static NodePtr absorb_into_rightmost(const NodePtr& n, std::string_view piece) {
+        if (n->is_leaf()) {
+            if (n->length + piece.size() > kSmallLeaf) return nullptr;
+            auto text = std::make_shared<std::string>();
+            text->reserve(n->length + piece.size());
+            text->append(n->view());
+            text->append(piece);
+            std::size_t len = text->size();
+            return make_leaf(std::move(text), 0, len);
+        }
+        NodePtr new_right = absorb_into_rightmost(n->right, piece);
+        if (!new_right) return nullptr;
+        return make_node(n->left, new_right);
+    }
+
+    template<typename Func>
+    static void visit_leaves(const NodePtr& n, Func& func) {
+        if (!n) return;
+        // 显式栈中序遍历，栈深度受树高限制
+        const Node* cur = n.get();
+        std::vector<const Node*> stack;
+        while (cur || !stack.empty()) {
+            while (cur) {
+                if (cur->is_leaf()) {
+                    func(cur->view());
+                    cur = nullptr;
+                } else {
+                    stack.push_back(cur);
+                    cur = cur->left.get();
+                }
+            }
+            if (!stack.empty()) {
+                cur = stack.back()->right.get();
+                stack.pop_back();
+            }
+        }
+    }
+
+public:
+    Rope() = default;
+
+    explicit Rope(std::string text) {
+        std::size_t len = text.size();
+        root = make_leaf(std::make_shared<const std::string>(std::move(text)), 0, len);
+    }
+
+    explicit Rope(const char* text) : Rope(std::string(text)) {}
+
+    std::size_t size() const { return length(root); }
+    bool empty() const { return !root; }
+    int depth() const { return height(root) + 1; }
+
+    char operator[](std::size_t index) const {
+        const Node* n = root.get();
+        while (!n->is_leaf()) {
+            if (index < n->left->length) {
+                n = n->left.get();
+            } else {
+                index -= n->left->length;
+                n = n->right.get();
+            }
+        }
+        return (*n->text)[n->offset + index];
+    }
+
+    char at(std::size_t index) const {
+        if (index >= size()) throw std::out_of_range("Rope::at");
+        return (*this)[index];
+    }
+
+    Rope& append(const Rope& other) {
+        root = join(root, other.root);
+        return *this;
+    }
+
+    Rope& append(std::string_view piece) {
+        if (piece.empty()) return *this;
+        if (root && piece.size() < kSmallLeaf) {
+            if (NodePtr absorbed = absorb_into_rightmost(root, piece)) {
+                root = std::move(absorbed);
+                return *this;
+            }
+        }
+        return append(Rope(std::string(piece)));
+    }
+
+    Rope& operator+=(const Rope& other) { return append(other); }
+    Rope& operator+=(std::string_view piece) { return append(piece); }
+
+    Rope& insert(std::size_t pos, const Rope& other) {
+        if (pos > size()) throw std::out_of_range("Rope::insert");
+        auto parts = split(root, pos);
+        root = join(join(parts.first, other.root), parts.second);
+        return *this;
+    }
+
+    Rope& erase(std::size_t pos, std::size_t count) {
+        if (pos > size()) throw std::out_of_range("Rope::erase");
+        auto head = split(root, pos);
+        auto tail = split(head.second, count);
+        root = join(head.first, tail.second);
+        return *this;
+    }
+
+    // 子串与原 Rope 共享字符数据
+    Rope substr(std::size_t pos, std::size_t count = std::string::npos) const {
+        if (pos > size()) throw std::out_of_range("Rope::substr");
+        auto tail = split(root, pos).second;
+        return Rope(split(tail, count).first);
+    }
+
+    // 依次访问每个连续片段，无需拼接
+    template<typename Func>
+    void for_each_chunk(Func func) const {
+        visit_leaves(root, func);
+    }
+
+    std::string str() const {
+        std::string result;
+        result.reserve(size());
+        for_each_chunk([&](std::string_view chunk) { result.append(chunk); });
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Rope& rope) {
+        rope.for_each_chunk([&](std::string_view chunk) { os << chunk; });
+        return os;
+    }
+};
+
+void demonstrate_join() {
+    std::cout << "\n=== join 算法 ===\n";
+
+    std::vector<std::string> words{"Hello", "World", "from", "join"};
+    std::cout << "join(words, \" \"): \"" << join(words, " ") << "\"\n";
+    std::cout << "join(words, \", \"): \"" << join(words, ", ") << "\"\n";
+
+    const char* letters[] = {"a", "b", "c"};
+    std::cout << "join(const char*[], \"-\"): \"" << join(letters, "-") << "\"\n";
+
+    std::vector<std::string> empty;
+    std::cout << "空范围: \"" << join(empty, ",") << "\"\n";
+}
+
+void demonstrate_string_builder() {
+    std::cout << "\n=== StringBuilder ===\n";
+
+    std::string name = "C++";
+    std::string version = "17";
+
+    StringBuilder sb;
+    sb << "语言: " << name << ", 标准: " << version;
+    // 临时字符串由 StringBuilder 接管，str() 时依然有效
+    sb << ", 发布年份: " << std::to_string(2017) << " (" + name + version + ")";
+    std::cout << "片段数: " << sb.part_count() << ", 总长度: " << sb.length() << "\n";
+    std::cout << "结果: " << sb.str() << "\n";
+}
+
+void demonstrate_rope() {
+    std::cout << "\n=== Rope ===\n";
+
+    Rope rope("Hello World");
+    std::cout << "初始: " << rope << " (长度 " << rope.size() << ")\n";
+
+    rope.append("!");
+    std::cout << "append(\"!\"): " << rope << "\n";
+
+    rope.insert(5, Rope(","));
+    std::cout << "insert(5, \",\"): " << rope << "\n";
+
+    Rope world = rope.substr(7, 5);
+    std::cout << "substr(7, 5): " << world << "\n";
+
+    rope.erase(0, 7);
+    std::cout << "erase(0, 7): " << rope << "\n";
+    std::cout << "rope[0]: " << rope[0] << ", 树深度: " << rope.depth() << "\n";
+
+    // 大量追加后树仍保持平衡
+    Rope big;
+    for (int i = 0; i < 100000; ++i) {
+        big.append(Rope(std::string(200, static_cast<char>('a' + i % 26))));
+    }
+    std::cout << "追加 100000 个 200 字节片段: 长度 " << big.size()
+              << ", 树深度 " << big.depth() << "\n";
+}
+
+void demonstrate_performance(std::size_t count) {
+    std::cout << "\n=== 性能对比 (片段数 = " << count << ") ===\n";
+
+    auto measure_time = [](auto func, const std::string& desc) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << desc << ": " << duration.count() << " μs\n";
+        return duration.count();
+    };
+
+    std::vector<std::string> fragments;
+    fragments.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        fragments.push_back("frag" + std::to_string(i % 1000) + " ");
+    }
+    std::size_t check = 0;
+
+    // accumulate 是 O(n²)，只在较小规模上演示
+    std::size_t small = std::min<std::size_t>(count, 20000);
+    std::cout << "\n小规模 (" << small << " 个片段):\n";
+    measure_time([&]() {
+        check += std::accumulate(fragments.begin(), fragments.begin() + small, std::string("")).size();
+    }, "std::accumulate");
+    measure_time([&]() {
+        check += join(fragments.begin(), fragments.begin() + small).size();
+    }, "join");
+
+    std::cout << "\n完整规模:\n";
+    auto t_append = measure_time([&]() {
+        std::string result;
+        for (const auto& f : fragments) result += f;
+        check += result.size();
+    }, "std::string::operator+=");
+    measure_time([&]() {
+        std::ostringstream oss;
+        for (const auto& f : fragments) oss << f;
+        check += oss.str().size();
+    }, "std::ostringstream");
+    auto t_join = measure_time([&]() {
+        check += join(fragments).size();
+    }, "join");
+    measure_time([&]() {
+        StringBuilder sb(fragments.size());
+        for (const auto& f : fragments) sb.append(f);
+        check += sb.str().size();
+    }, "StringBuilder");
+    measure_time([&]() {
+        Rope rope;
+        for (const auto& f : fragments) rope.append(f);
+        check += rope.str().size();
+    }, "Rope (append + str)");
+    std::cout << "   join vs operator+=: "
+              << static_cast<double>(t_append) / std::max<long long>(1, t_join) << "x\n";
+
+    // 中间插入：Rope 只复制 O(log n) 个节点，std::string 需要移动后半部分
+    std::cout << "\n中间插入 1000 次:\n";
+    std::string flat = join(fragments);
+    Rope rope(flat);
+    measure_time([&]() {
+        std::string s = flat;
+        for (int i = 0; i < 1000; ++i) s.insert(s.size() / 2, "INSERT");
+        check += s.size();
+    }, "std::string::insert");
+    measure_time([&]() {
+        Rope r = rope;
+        Rope piece("INSERT");
+        for (int i = 0; i < 1000; ++i) r.insert(r.size() / 2, piece);
+        check += r.size();
+    }, "Rope::insert");
+
+    std::cout << "\n(校验值: " << check << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 10: 字符串拼接演示\n";
+    std::cout << "================================\n";
+
+    std::size_t count = 1000000;
+    if (argc > 1) {
+        count = std::strtoull(argv[1], nullptr, 10);
+        if (count == 0) count = 1000000;
+    }
+
+    try {
+        demonstrate_join();
+        demonstrate_string_builder();
+        demonstrate_rope();
+        demonstrate_performance(count);
+
+    } catch (const std::exception& e) {
+        std::cerr << "异常: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
@@ -0,0 +1,696 @@
+/**
+ * @file memory_reclamation.cpp
+ * @brief 并发内存回收演示 - 风险指针、基于纪元的回收、RCU 风格的 rcu_ptr
+ *
+ * 无锁数据结构中，一个线程摘下节点后不能立即 delete：其他线程可能还持有它的指针。
+ * shared_ptr 靠引用计数解决，但每次读取都要对控制块做原子增减，读多时争用严重。
+ *   - 风险指针（hazard pointer）：读者把正在访问的指针登记到自己的槽位，
+ *     回收者只释放未被任何槽位登记的对象
+ *   - 基于纪元的回收（EBR）：读者进入临界区时记录全局纪元，对象按退休时的纪元
+ *     放入线程私有的待回收（limbo）列表，全局纪元前进两次后即可释放
+ *   - rcu_ptr<T>：读端只进出一次纪元临界区，写端复制-修改-发布，适合读多写少的配置对象
+ */
+
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+
+namespace reclaim {
+
+constexpr std::size_t kCacheLine = 64;
+constexpr std::size_t kMaxThreads = 128;
+
+// 类型擦除的待释放对象
+struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+
+    void reclaim() const { deleter(ptr); }
+};
+
+template<typename T>
+Retired make_retired(T* p) {
+    return {p, [](void* q) { delete static_cast<T*>(q); }};
+}
+
+// ===== 风险指针 =====
+class HazardDomain {
+public:
+    static constexpr std::size_t kSlotsPerThread = 4;
+
+private:
+    struct alignas(kCacheLine) Record {
+        std::atomic<void*> hazards[kSlotsPerThread] = {};
+        std::atomic<bool> in_use{false};
+    };
+
+    // 每个线程首次使用时占用一个记录，线程退出时把剩余的退休对象交给域
+    struct ThreadState {
+        HazardDomain* domain;
+        std::size_t index;
+        unsigned used_slots = 0;
+        std::vector<Retired> retired;
+
+        explicit ThreadState(HazardDomain* d) : domain(d), index(d->acquire_record()) {}
+        ~ThreadState() { domain->release_record(*this); }
+    };
+
+    Record records[kMaxThreads];
+    std::atomic<std::size_t> high_water{0};
+    std::mutex orphan_mutex;
+    std::vector<Retired> orphans;
+    std::atomic<std::size_t> reclaimed{0};
+
+    HazardDomain() = default;
+
+    ThreadState& local() {
+        thread_local ThreadState state(this);
+        return state;
+    }
+
+    std::size_t acquire_record() {
+        for (std::size_t i = 0; i < kMaxThreads; ++i) {
+            bool expected = false;
+            if (records[i].in_use.compare_exchange_strong(expected, true)) {
+                std::size_t hw = high_water.load();
+                while (hw < i + 1 && !high_water.compare_exchange_weak(hw, i + 1)) {}
+                return i;
+            }
+        }
+        throw std::runtime_error("风险指针记录不足：线程数超过上限");
+    }
+
+    void release_record(ThreadState& state) {
+        scan(state.retired);
+        for (auto& h : records[state.index].hazards) h.store(nullptr);
+        {
+            std::lock_guard<std::mutex> lock(orphan_mutex);
+            orphans.insert(orphans.end(), state.retired.begin(), state.retired.end());
+        }
+        state.retired.clear();
+        records[state.index].in_use.store(false);
+    }
+
+    // 收集所有登记的指针，释放不在其中的退休对象
+    void scan(std::vector<Retired>& list) {
+        // 退休对象已从数据结构中摘除；栅栏保证此后读取风险指针时不会与读者的登记互相错过
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(orphan_mutex, std::try_to_lock);
+            if (lock.owns_lock() && !orphans.empty()) {
+                list.insert(list.end(), orphans.begin(), orphans.end());
+                orphans.clear();
+            }
+        }
+
+        std::vector<void*> hazards;
+        std::size_t n = high_water.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (auto& h : records[i].hazards) {
+                if (void* p = h.load(std::memory_order_seq_cst)) hazards.push_back(p);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        auto keep_end = std::partition(list.begin(), list.end(), [&](const Retired& r) {
+            return std::binary_search(hazards.begin(), hazards.end(), r.ptr);
+        });
+        for (auto it = keep_end; it != list.end(); ++it) it->reclaim();
+        reclaimed.fetch_add(static_cast<std::size_t>(list.end() - keep_end), std::memory_order_relaxed);
+        list.erase(keep_end, list.end());
+    }
+
+public:
+    static HazardDomain& instance() {
+        static HazardDomain domain;
+        return domain;
+    }
+
+    ~HazardDomain() {
+        for (auto& r : orphans) r.reclaim();
+    }
+
+    std::atomic<void*>* acquire_slot() {
+        ThreadState& state = local();
+        for (std::size_t s = 0; s < kSlotsPerThread; ++s) {
+            if (!(state.used_slots & (1u << s))) {
+                state.used_slots |= 1u << s;
+                return &records[state.index].hazards[s];
+            }
+        }
+        throw std::runtime_error("每个线程最多同时持有 4 个风险指针");
+    }
+
+    void release_slot(std::atomic<void*>* slot) {
+        ThreadState& state = local();
+        std::size_t s = static_cast<std::size_t>(slot - records[state.index].hazards);
+        slot->store(nullptr, std::memory_order_release);
+        state.used_slots &= ~(1u << s);
+    }
+
+    // 退休列表超过登记槽位总数的两倍时扫描一次，摊还成本为 O(1)
+    template<typename T>
+    void retire(T* p) {
+        ThreadState& state = local();
+        state.retired.push_back(make_retired(p));
+        std::size_t threshold = 2 * kSlotsPerThread * high_water.load(std::memory_order_relaxed) + 64;
+        if (state.retired.size() >= threshold) scan(state.retired);
+    }
+
+    // 立即扫描当前线程的退休列表
+    void flush() { scan(local().retired); }
+
+    std::size_t reclaimed_count() const { return reclaimed.load(); }
+};
+
+// 占用一个风险指针槽位
+class HazardGuard {
+private:
+    std::atomic<void*>* slot;
+
+public:
+    HazardGuard() : slot(HazardDomain::instance().acquire_slot()) {}
+    ~HazardGuard() { HazardDomain::instance().release_slot(slot); }
+
+    HazardGuard(const HazardGuard&) = delete;
+    HazardGuard& operator=(const HazardGuard&) = delete;
+
+    // 登记后再读一次源指针确认未被替换，之后对象在 reset 前不会被释放
+    template<typename T>
+    T* protect(const std::atomic<T*>& src) {
+        T* p = src.load(std::memory_order_relaxed);
+        while (true) {
+            // 登记与复查都是 seq_cst，与 scan() 开头的 seq_cst 栅栏配对：
+            // 要么复查看到指针已被替换，要么 scan 看到这次登记
+            slot->store(p, std::memory_order_seq_cst);
+            T* again = src.load(std::memory_order_seq_cst);
+            if (again == p) return p;
+            p = again;
+        }
+    }
+
+    void reset() { slot->store(nullptr, std::memory_order_release); }
+};
+
+// ===== 基于纪元的回收 =====
+class EpochDomain {
+private:
+    static constexpr std::uint64_t kActive = 1;  // 记录的状态 = (纪元 << 1) | 活跃位
+    static constexpr std::size_t kAdvanceInterval = 64;
+
+    struct alignas(kCacheLine) Record {
+        std::atomic<std::uint64_t> state{0};
+        std::atomic<bool> in_use{false};
+    };
+
+    struct ThreadState {
+        EpochDomain* domain;
+        std::size_t index;
+        int nesting = 0;
+        std::vector<Retired> limbo[3];
+        std::uint64_t limbo_epoch[3] = {0, 0, 0};
+        std::size_t retire_count = 0;
+
+        explicit ThreadState(EpochDomain* d) : domain(d), index(d->acquire_record()) {}
+        ~ThreadState() { domain->release_record(*this); }
+    };
+
+    alignas(kCacheLine) std::atomic<std::uint64_t> global_epoch{0};
+    Record records[kMaxThreads];
+    std::atomic<std::size_t> high_water{0};
+    std::mutex orphan_mutex;
+    std::vector<std::pair<std::uint64_t, Retired>> orphans;
+    std::atomic<std::size_t> reclaimed{0};
+
+    EpochDomain() = default;
+
+    ThreadState& local() {
+        thread_local ThreadState state(this);
+        return state;
+    }
+
+    std::size_t acquire_record() {
+        for (std::size_t i = 0; i < kMaxThreads; ++i) {
+            bool expected = false;
+            if (records[i].in_use.compare_exchange_strong(expected, true)) {
+                std::size_t hw = high_water.load();
+                while (hw < i + 1 && !high_water.compare_exchange_weak(hw, i + 1)) {}
+                return i;
+            }
+        }
+        throw std::runtime_error("纪元记录不足：线程数超过上限");
+    }
+
+    void release_record(ThreadState& state) {
+        std::lock_guard<std::mutex> lock(orphan_mutex);
+        for (int i = 0; i < 3; ++i) {
+            for (const auto& r : state.limbo[i]) orphans.emplace_back(state.limbo_epoch[i], r);
+            state.limbo[i].clear();
+        }
+        records[state.index].state.store(0);
+        records[state.index].in_use.store(false);
+    }
+
+    void free_list(std::vector<Retired>& list) {
+        for (const auto& r : list) r.reclaim();
+        reclaimed.fetch_add(list.size(), std::memory_order_relaxed);
+        list.clear();
+    }
+
+    // 释放退休纪元比当前纪元早两个以上的对象
+    void collect(ThreadState& state) {
+        std::uint64_t e = global_epoch.load(std::memory_order_acquire);
+        for (int i = 0; i < 3; ++i) {
+            if (!state.limbo[i].empty() && state.limbo_epoch[i] + 2 <= e) free_list(state.limbo[i]);
+        }
+        std::unique_lock<std::mutex> lock(orphan_mutex, std::try_to_lock);
+        if (lock.owns_lock() && !orphans.empty()) {
+            auto it = std::partition(orphans.begin(), orphans.end(),
+                                     [e](const auto& o) { return o.first + 2 > e; });
+            for (auto j = it; j != orphans.end(); ++j) j->second.reclaim();
+            reclaimed.fetch_add(static_cast<std::size_t>(orphans.end() - it), std::memory_order_relaxed);
+            orphans.erase(it, orphans.end());
+        }
+    }
+
+public:
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    ~EpochDomain() {
+        for (auto& o : orphans) o.second.reclaim();
+    }
+
+    void enter() {
+        ThreadState& state = local();
+        if (state.nesting++ == 0) {
+            std::uint64_t e = global_epoch.load(std::memory_order_relaxed);
+            records[state.index].state.store((e << 1) | kActive, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void exit() {
+        ThreadState& state = local();
+        if (--state.nesting == 0) {
+            records[state.index].state.store(0, std::memory_order_release);
+        }
+    }
+
+    // 所有活跃线程都已观察到当前纪元时，全局纪元加 1
+    bool try_advance() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t e = global_epoch.load(std::memory_order_acquire);
+        std::size_t n = high_water.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint64_t s = records[i].state.load(std::memory_order_acquire);
+            if ((s & kActive) && (s >> 1) != e) return false;
+        }
+        return global_epoch.compare_exchange_strong(e, e + 1);
+    }
+
+    template<typename T>
+    void retire(T* p) {
+        ThreadState& state = local();
+        // 与 enter() 中的 seq_cst 栅栏配对：调用方摘除 p（可能在临界区之外）之后再读纪元，
+        // 保证读到的纪元不早于任何可能仍持有 p 的读者所钉住的纪元
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t e = global_epoch.load(std::memory_order_acquire);
+        std::size_t i = static_cast<std::size_t>(e % 3);
+        if (state.limbo_epoch[i] != e) {
+            // 同余的旧桶至少早三个纪元，可以直接释放
+            free_list(state.limbo[i]);
+            state.limbo_epoch[i] = e;
+        }
+        state.limbo[i].push_back(make_retired(p));
+        if (++state.retire_count % kAdvanceInterval == 0) {
+            try_advance();
+            collect(state);
+        }
+    }
+
+    // 等待宽限期结束（全局纪元前进两次），并释放本线程可回收的对象。
+    // 不能在临界区内调用，否则会等待自己
+    void synchronize() {
+        std::uint64_t target = global_epoch.load() + 2;
+        while (global_epoch.load() < target) {
+            if (!try_advance()) std::this_thread::yield();
+        }
+        collect(local());
+    }
+
+    std::uint64_t epoch() const { return global_epoch.load(); }
+    std::size_t reclaimed_count() const { return reclaimed.load(); }
+};
+
+// 纪元临界区，可嵌套
+class EpochGuard {
+public:
+    EpochGuard() { EpochDomain::instance().enter(); }
+    ~EpochGuard() { EpochDomain::instance().exit(); }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// ===== rcu_ptr =====
+// 读端：read() 返回的句柄存活期间对象不会被释放，读取路径上没有引用计数
+// 写端：update() 复制当前对象、修改副本后原子发布，旧对象交给纪元回收
+template<typename T>
+class rcu_ptr {
+private:
+    std::atomic<T*> current;
+    std::mutex writer_mutex;  // 写者之间串行，读者不受影响
+
+public:
+    class read_guard {
+    private:
+        EpochGuard guard;  // 先进入临界区再读取指针
+        const T* ptr;
+
+    public:
+        explicit read_guard(const std::atomic<T*>& src) : ptr(src.load(std::memory_order_acquire)) {}
+
+        const T* get() const { return ptr; }
+        const T& operator*() const { return *ptr; }
+        const T* operator->() const { return ptr; }
+    };
+
+    explicit rcu_ptr(std::unique_ptr<T> initial) : current(initial.release()) {}
+
+    rcu_ptr(const rcu_ptr&) = delete;
+    rcu_ptr& operator=(const rcu_ptr&) = delete;
+
+    // 析构时要求已没有读者
+    ~rcu_ptr() { delete current.load(); }
+
+    read_guard read() const { return read_guard(current); }
+
+    void store(std::unique_ptr<T> next) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        publish(std::move(next));
+    }
+
+    // 复制时处于纪元临界区内：即使另有写者绕过本对象发布，旧对象也不会在复制途中被回收
+    template<typename F>
+    void update(F&& mutate) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        std::unique_ptr<T> copy;
+        {
+            EpochGuard guard;
+            copy = std::make_unique<T>(*current.load(std::memory_order_acquire));
+        }
+        mutate(*copy);
+        publish(std::move(copy));
+    }
+
+private:
+    // 调用方须持有 writer_mutex
+    void publish(std::unique_ptr<T> next) {
+        T* old = current.exchange(next.release(), std::memory_order_acq_rel);
+        EpochDomain::instance().retire(old);
+    }
+};
+
+} // namespace reclaim
+
+// 读多写少的配置对象，统计存活实例数以观察回收
+struct Config {
+    static std::atomic<int> live;
+
+    int version = 0;
+    std::string name;
+    std::vector<int> limits;
+
+    Config(int v, std::string n, std::vector<int> l) : version(v), name(std::move(n)), limits(std::move(l)) {
+        ++live;
+    }
+    Config(const Config& other) : version(other.version), name(other.name), limits(other.limits) {
+        ++live;
+    }
+    ~Config() { --live; }
+};
+
+std::atomic<int> Config::live{0};
+
+// 使用风险指针的无锁栈：pop 在读取 top->next 前先登记 top
+template<typename T>
+class HazardStack {
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head{nullptr};
+
+public:
+    ~HazardStack() {
+        Node* n = head.load();
+        while (n) {
+            Node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    void push(T value) {
+        Node* node = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                           std::memory_order_relaxed)) {}
+    }
+
+    bool pop(T& out) {
+        reclaim::HazardGuard guard;
+        while (true) {
+            Node* top = guard.protect(head);
+            if (!top) return false;
+            Node* next = top->next;
+            if (head.compare_exchange_strong(top, next, std::memory_order_acq_rel)) {
+                out = std::move(top->value);
+                guard.reset();
+                reclaim::HazardDomain::instance().retire(top);
+                return true;
+            }
+        }
+    }
+};
+
+void demonstrate_hazard_pointers() {
+    std::cout << "\n=== 风险指针 ===\n";
+
+    auto& domain = reclaim::HazardDomain::instance();
+    std::size_t before = domain.reclaimed_count();
+
+    HazardStack<int> stack;
+    const int threads = 4;
+    const int per_thread = 50000;
+    std::atomic<long long> sum{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            long long local_sum = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                stack.push(t * per_thread + i);
+                int v;
+                if (stack.pop(v)) local_sum += v;
+            }
+            sum += local_sum;
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    int v;
+    long long rest = 0;
+    while (stack.pop(v)) rest += v;
+    domain.flush();
+
+    long long n = static_cast<long long>(threads) * per_thread;
+    std::cout << threads << " 个线程 push/pop " << n << " 次, 总和校验: "
+              << (sum + rest == n * (n - 1) / 2 ? "正确" : "错误") << "\n";
+    std::cout << "已回收节点: " << domain.reclaimed_count() - before << "\n";
+
+    // 登记中的指针不会被回收
+    std::atomic<Config*> shared{new Config(1, "hp", {1})};
+    {
+        reclaim::HazardGuard guard;
+        Config* p = guard.protect(shared);
+        Config* old = shared.exchange(new Config(2, "hp", {2}));
+        domain.retire(old);
+        domain.flush();
+        std::cout << "受保护对象在 flush 后仍可访问: version=" << p->version
+                  << ", 存活 Config 数: " << Config::live << "\n";
+    }
+    domain.flush();
+    std::cout << "释放保护后 flush, 存活 Config 数: " << Config::live << "\n";
+    delete shared.load();
+}
+
+void demonstrate_epoch_reclamation() {
+    std::cout << "\n=== 基于纪元的回收 ===\n";
+
+    auto& domain = reclaim::EpochDomain::instance();
+    std::cout << "当前全局纪元: " << domain.epoch() << "\n";
+
+    std::atomic<Config*> shared{new Config(1, "ebr", {1})};
+    {
+        reclaim::EpochGuard guard;
+        Config* p = shared.load();
+        domain.retire(shared.exchange(new Config(2, "ebr", {2})));
+        bool first = domain.try_advance();
+        bool second = domain.try_advance();
+        std::cout << "临界区内推进纪元: 第一次" << (first ? "成功" : "失败")
+                  << ", 第二次" << (second ? "成功" : "失败") << "（读者停留在旧纪元）\n";
+        std::cout << "临界区内旧对象仍可访问: version=" << p->version << "\n";
+    }
+    domain.synchronize();
+    std::cout << "宽限期结束后纪元: " << domain.epoch()
+              << ", 存活 Config 数: " << Config::live << "\n";
+    delete shared.load();
+}
+
+void demonstrate_rcu_ptr() {
+    std::cout << "\n=== rcu_ptr ===\n";
+
+    reclaim::rcu_ptr<Config> config(std::make_unique<Config>(1, "default", std::vector<int>{10, 20}));
+
+    std::atomic<bool> stop{false};
+    std::atomic<long long> reads{0};
+    std::atomic<bool> consistent{true};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            long long local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto cfg = config.read();
+                // 写端保证 limits[0] == version * 10，读到的始终是完整的某个版本
+                if (cfg->limits[0] != cfg->version * 10) consistent = false;
+                ++local;
+            }
+            reads += local;
+        });
+    }
+
+    for (int v = 2; v <= 200; ++v) {
+        config.update([v](Config& c) {
+            c.version = v;
+            c.limits[0] = v * 10;
+        });
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    stop = true;
+    for (auto& t : readers) t.join();
+    reclaim::EpochDomain::instance().synchronize();
+
+    std::cout << "199 次更新期间读取 " << reads << " 次, 数据一致: "
+              << (consistent ? "是" : "否") << "\n";
+    std::cout << "最终版本: " << config.read()->version
+              << ", 存活 Config 数: " << Config::live << "\n";
+}
+
+// 读端开销对比：readers 个读线程各读 reads_per_thread 次，同时一个写线程每 100μs 更新一次
+template<typename ReadFn, typename WriteFn>
+double measure_read_cost(int readers, int reads_per_thread, ReadFn read_once, WriteFn write_once) {
+    std::atomic<bool> stop{false};
+    std::atomic<int> ready{0};
+    std::atomic<long long> sink{0};
+
+    std::thread writer([&]() {
+        int v = 0;
+        while (!stop.load()) {
+            write_once(++v);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&]() {
+            ++ready;
+            long long local = 0;
+            for (int i = 0; i < reads_per_thread; ++i) local += read_once();
+            sink += local;
+        });
+    }
+    for (auto& t : threads) t.join();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    stop = true;
+    writer.join();
+
+    double total_ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return total_ns / (static_cast<double>(readers) * reads_per_thread);
+}
+
+void demonstrate_performance(int reads_per_thread) {
+    std::cout << "\n=== 读端开销对比 (每次读取平均耗时) ===\n";
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency() << "\n";
+
+    for (int readers : {1, 2, 4}) {
+        std::cout << "\n" << readers << " 个读线程 + 1 个写线程:\n";
+
+        // C++17 没有 std::atomic<std::shared_ptr>，使用 atomic_load/atomic_store 自由函数
+        auto sp = std::make_shared<const Config>(0, "sp", std::vector<int>{0});
+        double t_sp = measure_read_cost(readers, reads_per_thread,
+            [&]() { return std::atomic_load(&sp)->limits[0]; },
+            [&](int v) { std::atomic_store(&sp, std::make_shared<const Config>(v, "sp", std::vector<int>{v})); });
+        std::cout << "   atomic_load(shared_ptr): " << t_sp << " ns\n";
+
+        std::atomic<Config*> hp_ptr{new Config(0, "hp", {0})};
+        double t_hp = measure_read_cost(readers, reads_per_thread,
+            [&]() {
+                thread_local reclaim::HazardGuard guard;
+                int value = guard.protect(hp_ptr)->limits[0];
+                guard.reset();
+                return value;
+            },
+            [&](int v) {
+                reclaim::HazardDomain::instance().retire(hp_ptr.exchange(new Config(v, "hp", {v})));
+            });
+        delete hp_ptr.load();
+        std::cout << "   风险指针: " << t_hp << " ns\n";
+
+        reclaim::rcu_ptr<Config> rcu(std::make_unique<Config>(0, "rcu", std::vector<int>{0}));
+        double t_rcu = measure_read_cost(readers, reads_per_thread,
+            [&]() { return rcu.read()->limits[0]; },
+            [&](int v) { rcu.store(std::make_unique<Config>(v, "rcu", std::vector<int>{v})); });
+        reclaim::EpochDomain::instance().synchronize();
+        std::cout << "   rcu_ptr (纪元): " << t_rcu << " ns\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 12: 并发内存回收\n";
+    std::cout << "=================================\n";
+
+    try {
+        demonstrate_hazard_pointers();
+        demonstrate_epoch_reclamation();
+        demonstrate_rcu_ptr();
+
+        int reads = argc > 1 ? std::atoi(argv[1]) : 2000000;
+        demonstrate_performance(reads);
+
+    } catch (const std::exception& e) {
+        std::cerr << "异常: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
@@ -0,0 +1,364 @@
+/**
+ * @file node_arena.cpp
+ * @brief 基于索引句柄的节点存储演示 - 用竞技场（arena）替代 shared_ptr 链接与裸指针树
+ *
+ * smart_pointers.cpp 中的 Node 用 shared_ptr<Node> next / weak_ptr<Node> parent 链接，
+ * recursive_functions.cpp 中的 TreeNode 用裸指针并逐个 new。这里把节点放进按列存储（SoA）
+ * 的连续数组中：
+ *   - 节点之间用 32 位下标链接，按列连续存放，遍历时只读需要的列
+ *   - 对外的 NodeHandle 额外携带代数（generation），槽位释放后旧句柄可被检测出来
+ *   - clear() 一次性释放全部节点，不逐个调用分配器
+ * 以及与逐节点 new 的指针树在建树、遍历、销毁上的对比。
+ */
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <string>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+
+// 堆分配计数：验证建树与遍历不会逐节点调用全局分配器
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// 对外句柄：下标 + 代数；内部链接只存下标
+struct NodeHandle {
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+};
+
+// T 为节点负载，Links 为每个节点的链接列数（如 next/parent，或 left/right/parent）
+template<typename T, std::size_t Links>
+class NodeArena {
+public:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+private:
+    std::vector<T> values;
+    std::array<std::vector<std::uint32_t>, Links> links;
+    std::vector<std::uint32_t> generations;   // 奇数表示槽位空闲
+    std::vector<std::uint32_t> free_slots;
+    std::uint32_t high_water = 0;             // 本轮使用过的槽位数
+    std::size_t live = 0;
+
+    bool is_live(std::uint32_t index) const {
+        return index < high_water && (generations[index] & 1u) == 0;
+    }
+
+    void check(NodeHandle h) const {
+        if (!valid(h)) {
+            throw std::invalid_argument("NodeArena: 句柄已失效或不属于本竞技场");
+        }
+    }
+
+public:
+    NodeArena() = default;
+    explicit NodeArena(std::size_t n) { reserve(n); }
+
+    void reserve(std::size_t n) {
+        if (n > npos) throw std::length_error("NodeArena: 节点数超过 32 位下标范围");
+        values.reserve(n);
+        for (auto& column : links) column.reserve(n);
+        generations.reserve(n);
+    }
+
+    NodeHandle create(T value = T()) {
+        std::uint32_t index;
+        if (!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        } else if (high_water < generations.size()) {
+            index = high_water++;     // clear() 之后复用的槽位，保留代数
+        } else {
+            if (high_water == npos) throw std::length_error("NodeArena: 节点数超过 32 位下标范围");
+            index = high_water++;
+            values.emplace_back();
+            for (auto& column : links) column.push_back(npos);
+            generations.push_back(1);
+        }
+        values[index] = std::move(value);
+        for (auto& column : links) column[index] = npos;
+        ++generations[index];         // 变为偶数：存活
+        ++live;
+        return {index, generations[index]};
+    }
+
+    void destroy(NodeHandle h) {
+        check(h);
+        if (!std::is_trivially_destructible<T>::value) values[h.index] = T();
+        ++generations[h.index];       // 变为奇数：旧句柄全部失效
+        free_slots.push_back(h.index);
+        --live;
+    }
+
+    // 批量释放：只递增代数，不逐个归还内存，列数组留给下一轮复用
+    void clear() {
+        for (std::uint32_t i = 0; i < high_water; ++i) {
+            if ((generations[i] & 1u) == 0) {
+                ++generations[i];
+                if (!std::is_trivially_destructible<T>::value) values[i] = T();
+            }
+        }
+        free_slots.clear();
+        high_water = 0;
+        live = 0;
+    }
+
+    bool valid(NodeHandle h) const {
+        return h.index < high_water && generations[h.index] == h.generation && (h.generation & 1u) == 0;
+    }
+
+    NodeHandle handle_of(std::uint32_t index) const {
+        if (!is_live(index)) throw std::out_of_range("NodeArena: 下标不是存活节点");
+        return {index, generations[index]};
+    }
+
+    // 带检查的访问：用于对外句柄
+    T& operator[](NodeHandle h) { check(h); return values[h.index]; }
+    const T& operator[](NodeHandle h) const { check(h); return values[h.index]; }
+
+    void set_link(NodeHandle from, std::size_t slot, NodeHandle to) {
+        check(from);
+        check(to);
+        links[slot][from.index] = to.index;
+    }
+
+    NodeHandle get_link(NodeHandle from, std::size_t slot) const {
+        check(from);
+        std::uint32_t target = links[slot][from.index];
+        return target == npos ? NodeHandle{} : handle_of(target);
+    }
+
+    // 不检查的下标访问：用于内部遍历等热路径
+    T& value(std::uint32_t index) { return values[index]; }
+    const T& value(std::uint32_t index) const { return values[index]; }
+    std::uint32_t& link(std::uint32_t index, std::size_t slot) { return links[slot][index]; }
+    std::uint32_t link(std::uint32_t index, std::size_t slot) const { return links[slot][index]; }
+
+    std::size_t size() const { return live; }
+    std::size_t capacity() const { return generations.capacity(); }
+};
+
+// 与 smart_pointers.cpp 中 Node 对应：next/parent 都是下标，无需 weak_ptr 打破循环
+enum ListLink : std::size_t { Next, Parent };
+using NodeStore = NodeArena<std::string, 2>;
+
+void demonstrate_handles() {
+    std::cout << "\n=== 句柄与代数检测 ===\n";
+
+    NodeStore store;
+    NodeHandle parent = store.create("父节点");
+    NodeHandle child = store.create("子节点");
+
+    store.set_link(parent, Next, child);
+    store.set_link(child, Parent, parent);
+
+    std::cout << "父节点的 next: " << store[store.get_link(parent, Next)] << "\n";
+    std::cout << "子节点的 parent: " << store[store.get_link(child, Parent)] << "\n";
+    std::cout << "节点数: " << store.size() << "\n";
+
+    store.destroy(child);
+    std::cout << "销毁子节点后旧句柄是否有效: " << (store.valid(child) ? "是" : "否") << "\n";
+
+    NodeHandle reused = store.create("复用槽位的新节点");
+    std::cout << "新节点复用下标 " << reused.index << " (旧句柄下标 " << child.index
+              << "), 代数 " << child.generation << " -> " << reused.generation << "\n";
+
+    try {
+        std::cout << store[child] << "\n";
+    } catch (const std::invalid_argument& e) {
+        std::cout << "通过旧句柄访问: " << e.what() << "\n";
+    }
+
+    // 父节点的 next 仍指向该下标：下标链接不带代数，删除节点时应由调用者维护链接
+    store.clear();
+    std::cout << "clear() 后节点数: " << store.size()
+              << ", 父节点句柄是否有效: " << (store.valid(parent) ? "是" : "否") << "\n";
+}
+
+// ===== 二叉树：指针版与竞技场版 =====
+struct TreeNode {
+    int data;
+    TreeNode* left;
+    TreeNode* right;
+    TreeNode* parent;
+
+    TreeNode(int val, TreeNode* p) : data(val), left(nullptr), right(nullptr), parent(p) {}
+};
+
+enum TreeLink : std::size_t { Left, Right, Up };
+using TreeArena = NodeArena<int, 3>;
+
+// 由有序区间 [0, n) 构建平衡二叉搜索树，显式栈代替递归
+TreeNode* build_pointer_tree(int n) {
+    if (n <= 0) return nullptr;
+    struct Task { TreeNode* parent; bool is_left; int lo, hi; };
+    TreeNode* root = nullptr;
+    std::vector<Task> stack{{nullptr, false, 0, n}};
+    while (!stack.empty()) {
+        Task t = stack.back();
+        stack.pop_back();
+        int mid = t.lo + (t.hi - t.lo) / 2;
+        TreeNode* node = new TreeNode(mid, t.parent);
+        if (!t.parent) root = node;
+        else if (t.is_left) t.parent->left = node;
+        else t.parent->right = node;
+        if (mid + 1 < t.hi) stack.push_back({node, false, mid + 1, t.hi});
+        if (t.lo < mid) stack.push_back({node, true, t.lo, mid});
+    }
+    return root;
+}
+
+std::uint32_t build_arena_tree(TreeArena& arena, int n) {
+    if (n <= 0) return TreeArena::npos;
+    struct Task { std::uint32_t parent; bool is_left; int lo, hi; };
+    std::vector<Task> stack{{TreeArena::npos, false, 0, n}};
+    std::uint32_t root = TreeArena::npos;
+    while (!stack.empty()) {
+        Task t = stack.back();
+        stack.pop_back();
+        int mid = t.lo + (t.hi - t.lo) / 2;
+        std::uint32_t node = arena.create(mid).index;
+        arena.link(node, Up) = t.parent;
+        if (t.parent == TreeArena::npos) root = node;
+        else arena.link(t.parent, t.is_left ? Left : Right) = node;
+        if (mid + 1 < t.hi) stack.push_back({node, false, mid + 1, t.hi});
+        if (t.lo < mid) stack.push_back({node, true, t.lo, mid});
+    }
+    return root;
+}
+
+// 中序遍历：借助 parent 链接，不需要栈，也就没有额外分配
+long long inorder_sum(const TreeNode* root) {
+    long long sum = 0;
+    const TreeNode* node = root;
+    while (node && node->left) node = node->left;
+    while (node) {
+        sum += node->data;
+        if (node->right) {
+            node = node->right;
+            while (node->left) node = node->left;
+        } else {
+            while (node->parent && node->parent->right == node) node = node->parent;
+            node = node->parent;
+        }
+    }
+    return sum;
+}
+
+long long inorder_sum(const TreeArena& arena, std::uint32_t root) {
+    constexpr std::uint32_t npos = TreeArena::npos;
+    long long sum = 0;
+    std::uint32_t node = root;
+    while (node != npos && arena.link(node, Left) != npos) node = arena.link(node, Left);
+    while (node != npos) {
+        sum += arena.value(node);
+        if (arena.link(node, Right) != npos) {
+            node = arena.link(node, Right);
+            while (arena.link(node, Left) != npos) node = arena.link(node, Left);
+        } else {
+            std::uint32_t up = arena.link(node, Up);
+            while (up != npos && arena.link(up, Right) == node) {
+                node = up;
+                up = arena.link(node, Up);
+            }
+            node = up;
+        }
+    }
+    return sum;
+}
+
+// 后序逐个 delete，同样借助 parent 链接避免递归
+void destroy_pointer_tree(TreeNode* root) {
+    TreeNode* node = root;
+    while (node) {
+        if (node->left) node = node->left;
+        else if (node->right) node = node->right;
+        else {
+            TreeNode* parent = node->parent;
+            if (parent) {
+                if (parent->left == node) parent->left = nullptr;
+                else parent->right = nullptr;
+            }
+            delete node;
+            node = parent;
+        }
+    }
+}
+
+void demonstrate_tree_performance(int n) {
+    std::cout << "\n=== 建树性能对比 (" << n << " 个节点) ===\n";
+
+    auto measure_time = [](const std::string& name, auto&& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::size_t alloc_before = g_allocations;
+        func();
+        std::size_t allocations = g_allocations - alloc_before;
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << name << ": " << duration.count() << " μs, 堆分配 " << allocations << " 次\n";
+    };
+
+    long long expected = static_cast<long long>(n) * (n - 1) / 2;
+
+    {
+        std::cout << "逐节点 new 的指针树 (" << sizeof(TreeNode) << " 字节/节点):\n";
+        TreeNode* root = nullptr;
+        long long sum = 0;
+        measure_time("建树", [&]() { root = build_pointer_tree(n); });
+        measure_time("中序遍历", [&]() { sum = inorder_sum(root); });
+        measure_time("销毁", [&]() { destroy_pointer_tree(root); });
+        std::cout << "   校验: " << (sum == expected ? "通过" : "失败") << "\n";
+    }
+
+    {
+        std::cout << "竞技场 (" << sizeof(int) + 4 * sizeof(std::uint32_t) << " 字节/节点):\n";
+        TreeArena arena;
+        std::uint32_t root = TreeArena::npos;
+        long long sum = 0;
+        measure_time("预留", [&]() { arena.reserve(n); });
+        measure_time("建树", [&]() { root = build_arena_tree(arena, n); });
+        measure_time("中序遍历", [&]() { sum = inorder_sum(arena, root); });
+        measure_time("批量释放", [&]() { arena.clear(); });
+        measure_time("复用槽位重建", [&]() { root = build_arena_tree(arena, n); });
+        std::cout << "   校验: " << (sum == expected && inorder_sum(arena, root) == expected ? "通过" : "失败") << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 12: 基于索引句柄的节点存储\n";
+    std::cout << "=================================\n";
+
+    try {
+        demonstrate_handles();
+
+        // 1 亿节点约需 2GB 内存，通过参数显式开启：./node_arena 100000000
+        int nodes = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+        demonstrate_tree_performance(nodes);
+
+    } catch (const std::exception& e) {
+        std::cerr << "异常: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
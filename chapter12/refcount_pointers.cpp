@@ -0,0 +1,609 @@
+/**
+ * @file refcount_pointers.cpp
+ * @brief 引用计数指针变体演示 - 非原子的 local_shared_ptr 与偏向引用计数 biased_ptr
+ *
+ * smart_pointers.cpp 中 Node 的 next/parent 都用 shared_ptr/weak_ptr，每次拷贝都要
+ * 原子地修改控制块，即使整个图只在一个线程中构建。
+ *   - local_shared_ptr / local_weak_ptr：计数是普通整数，只能在一个线程内拷贝；
+ *     转换为 std::shared_ptr 时整组本地指针只占一个原子引用，可以安全地交给其他线程
+ *   - biased_ptr：对象记录创建它的线程（owner），owner 线程用非原子的偏向计数，
+ *     其他线程用原子的共享计数；两部分在偏向计数归零或共享计数变负时合并
+ * 以及建图/遍历/销毁的性能对比。
+ */
+
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+
+// ===== local_shared_ptr =====
+template<typename T> class local_shared_ptr;
+template<typename T> class local_weak_ptr;
+
+namespace local_detail {
+
+// strong/weak 只在所属线程访问；object_refs/block_refs 计算的是"本地组"（算 1 个）
+// 加上转换出的每组 std::shared_ptr，只有它们需要原子操作
+struct ControlBlock {
+    long strong = 1;                    // local_shared_ptr 个数
+    long weak = 1;                      // local_weak_ptr 个数 + (strong > 0 ? 1 : 0)
+    std::atomic<long> object_refs{1};
+    std::atomic<long> block_refs{1};
+
+    virtual ~ControlBlock() = default;
+    virtual void destroy_object() = 0;
+
+    void release_object_ref() {
+        if (object_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) destroy_object();
+    }
+
+    void release_block_ref() {
+        if (block_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+};
+
+// make_local_shared：对象与控制块一次分配
+template<typename T>
+struct InplaceBlock : ControlBlock {
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    template<typename... Args>
+    explicit InplaceBlock(Args&&... args) {
+        new (storage) T(std::forward<Args>(args)...);
+    }
+
+    T* get() { return reinterpret_cast<T*>(storage); }
+    void destroy_object() override { get()->~T(); }
+};
+
+// 从 std::shared_ptr 转换而来：持有一份 std::shared_ptr
+template<typename T>
+struct AdoptSharedBlock : ControlBlock {
+    std::shared_ptr<T> owner;
+
+    explicit AdoptSharedBlock(std::shared_ptr<T> p) : owner(std::move(p)) {}
+    void destroy_object() override { owner.reset(); }
+};
+
+} // namespace local_detail
+
+template<typename T>
+class local_shared_ptr {
+private:
+    T* ptr = nullptr;
+    local_detail::ControlBlock* block = nullptr;
+
+    template<typename U> friend class local_weak_ptr;
+    template<typename U, typename... Args>
+    friend local_shared_ptr<U> make_local_shared(Args&&... args);
+
+    // 接管一个已计入的强引用
+    local_shared_ptr(T* p, local_detail::ControlBlock* b) : ptr(p), block(b) {}
+
+    void release() {
+        if (block && --block->strong == 0) {
+            block->release_object_ref();
+            if (--block->weak == 0) block->release_block_ref();
+        }
+    }
+
+public:
+    local_shared_ptr() = default;
+    local_shared_ptr(std::nullptr_t) {}
+
+    // 从 std::shared_ptr 转换：之后的拷贝都不再是原子操作
+    explicit local_shared_ptr(std::shared_ptr<T> sp)
+        : ptr(sp.get()), block(sp ? new local_detail::AdoptSharedBlock<T>(std::move(sp)) : nullptr) {}
+
+    local_shared_ptr(const local_shared_ptr& other) : ptr(other.ptr), block(other.block) {
+        if (block) ++block->strong;
+    }
+
+    local_shared_ptr(local_shared_ptr&& other) noexcept : ptr(other.ptr), block(other.block) {
+        other.ptr = nullptr;
+        other.block = nullptr;
+    }
+
+    local_shared_ptr& operator=(local_shared_ptr other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(block, other.block);
+        return *this;
+    }
+
+    ~local_shared_ptr() { release(); }
+
+    void reset() { local_shared_ptr().swap(*this); }
+    void swap(local_shared_ptr& other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(block, other.block);
+    }
+
+    T* get() const { return ptr; }
+    T& operator*() const { return *ptr; }
+    T* operator->() const { return ptr; }
+    explicit operator bool() const { return ptr != nullptr; }
+    long use_count() const { return block ? block->strong : 0; }
+
+    // 转换为 std::shared_ptr：整组本地指针只增加一个原子引用，结果可以交给其他线程
+    std::shared_ptr<T> to_shared() const {
+        if (!block) return {};
+        block->object_refs.fetch_add(1, std::memory_order_relaxed);
+        block->block_refs.fetch_add(1, std::memory_order_relaxed);
+        local_detail::ControlBlock* b = block;
+        return std::shared_ptr<T>(ptr, [b](T*) {
+            b->release_object_ref();
+            b->release_block_ref();
+        });
+    }
+};
+
+template<typename T, typename... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args) {
+    auto* block = new local_detail::InplaceBlock<T>(std::forward<Args>(args)...);
+    return local_shared_ptr<T>(block->get(), block);
+}
+
+template<typename T>
+class local_weak_ptr {
+private:
+    T* ptr = nullptr;
+    local_detail::ControlBlock* block = nullptr;
+
+public:
+    local_weak_ptr() = default;
+
+    local_weak_ptr(const local_shared_ptr<T>& sp) : ptr(sp.ptr), block(sp.block) {
+        if (block) ++block->weak;
+    }
+
+    local_weak_ptr(const local_weak_ptr& other) : ptr(other.ptr), block(other.block) {
+        if (block) ++block->weak;
+    }
+
+    local_weak_ptr& operator=(local_weak_ptr other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(block, other.block);
+        return *this;
+    }
+
+    ~local_weak_ptr() {
+        if (block && --block->weak == 0) block->release_block_ref();
+    }
+
+    bool expired() const {
+        return !block || block->object_refs.load(std::memory_order_acquire) == 0;
+    }
+
+    local_shared_ptr<T> lock() const {
+        if (!block) return {};
+        if (block->strong > 0) {
+            ++block->strong;
+            return local_shared_ptr<T>(ptr, block);
+        }
+        // 本地强引用已全部释放，但转换出的 std::shared_ptr 可能仍让对象存活
+        long n = block->object_refs.load(std::memory_order_acquire);
+        while (n > 0) {
+            if (block->object_refs.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel)) {
+                block->strong = 1;
+                ++block->weak;
+                return local_shared_ptr<T>(ptr, block);
+            }
+        }
+        return {};
+    }
+};
+
+// ===== biased_ptr =====
+namespace biased_detail {
+
+// 共享计数的编码：(count << 2) | QUEUED | MERGED，count 可以暂时为负
+constexpr std::int64_t kMerged = 1;
+constexpr std::int64_t kQueued = 2;
+constexpr std::int64_t kUnit = 4;
+
+inline std::int64_t count_of(std::int64_t s) { return (s - (s & 3)) / kUnit; }
+
+struct Header;
+
+// 每个线程一个合并队列：其他线程把共享计数减成负数时，把对象交给 owner 合并
+struct MergeQueue {
+    std::mutex mtx;
+    std::vector<Header*> pending;
+    std::atomic<bool> has_pending{false};
+    bool alive = true;
+};
+
+struct Header {
+    const std::uint64_t owner;
+    std::shared_ptr<MergeQueue> owner_queue;
+    long biased = 1;       // 只由 owner 线程读写
+    bool merged = false;   // 只由 owner 线程读写
+    std::atomic<std::int64_t> shared{0};
+
+    Header(std::uint64_t id, std::shared_ptr<MergeQueue> queue) : owner(id), owner_queue(std::move(queue)) {}
+    virtual ~Header() = default;
+};
+
+void merge_from_queue(Header* h);
+
+struct ThreadContext {
+    std::uint64_t id;
+    std::shared_ptr<MergeQueue> queue = std::make_shared<MergeQueue>();
+
+    ThreadContext() {
+        static std::atomic<std::uint64_t> next_id{1};
+        id = next_id.fetch_add(1);
+    }
+
+    // 线程退出：此后的入队请求由发起方自行合并
+    ~ThreadContext() {
+        std::vector<Header*> rest;
+        {
+            std::lock_guard<std::mutex> lock(queue->mtx);
+            queue->alive = false;
+            rest.swap(queue->pending);
+        }
+        for (Header* h : rest) merge_from_queue(h);
+    }
+};
+
+inline ThreadContext& context() {
+    thread_local ThreadContext ctx;
+    return ctx;
+}
+
+// 把偏向计数并入共享计数并设置 MERGED，总数为 0 时释放对象。
+// 发布 MERGED 的 CAS 成功后其他线程就可能把计数减到 0 并释放对象，
+// 所以 owner 私有字段必须在 CAS 之前写好，CAS 之后只在 total == 0 时再访问 h
+inline void merge_from_queue(Header* h) {
+    long biased = h->biased;
+    h->biased = 0;
+    h->merged = true;
+    std::int64_t s = h->shared.load(std::memory_order_acquire);
+    while (true) {
+        std::int64_t total = count_of(s) + biased;
+        if (h->shared.compare_exchange_weak(s, total * kUnit | kMerged, std::memory_order_acq_rel)) {
+            if (total == 0) delete h;
+            return;
+        }
+    }
+}
+
+inline void process_pending() {
+    MergeQueue& q = *context().queue;
+    if (!q.has_pending.load(std::memory_order_acquire)) return;
+    std::vector<Header*> work;
+    {
+        std::lock_guard<std::mutex> lock(q.mtx);
+        work.swap(q.pending);
+        q.has_pending.store(false, std::memory_order_relaxed);
+    }
+    for (Header* h : work) merge_from_queue(h);
+}
+
+inline void enqueue(Header* h) {
+    MergeQueue& q = *h->owner_queue;
+    {
+        std::lock_guard<std::mutex> lock(q.mtx);
+        if (q.alive) {
+            q.pending.push_back(h);
+            q.has_pending.store(true, std::memory_order_release);
+            return;
+        }
+    }
+    // owner 已退出，偏向计数不会再变化；合并可能释放对象及其持有的队列，需在解锁后进行
+    merge_from_queue(h);
+}
+
+inline void increment(Header* h) {
+    if (h->owner == context().id && !h->merged) {
+        ++h->biased;
+    } else {
+        h->shared.fetch_add(kUnit, std::memory_order_relaxed);
+    }
+}
+
+inline void decrement(Header* h) {
+    if (h->owner == context().id && !h->merged) {
+        if (--h->biased == 0) {
+            // owner 不再持有引用：若对象未在合并队列中，立即合并。
+            // merged 只有 owner 读取，先置位，对象已入队（由队列负责合并）时再撤销
+            h->merged = true;
+            std::int64_t s = h->shared.load(std::memory_order_acquire);
+            while (true) {
+                if (s & kQueued) {
+                    h->merged = false;
+                    break;
+                }
+                std::int64_t total = count_of(s);
+                if (h->shared.compare_exchange_weak(s, total * kUnit | kMerged, std::memory_order_acq_rel)) {
+                    if (total == 0) delete h;
+                    break;
+                }
+            }
+        }
+        process_pending();
+        return;
+    }
+
+    // 减计数与设置 QUEUED 在同一次 CAS 中完成，保证对象入队前不会被释放
+    std::int64_t s = h->shared.load(std::memory_order_relaxed);
+    while (true) {
+        std::int64_t now = count_of(s) - 1;
+        bool to_queue = !(s & kMerged) && now < 0 && !(s & kQueued);
+        std::int64_t desired = (s - kUnit) | (to_queue ? kQueued : 0);
+        if (h->shared.compare_exchange_weak(s, desired, std::memory_order_acq_rel)) {
+            if ((s & kMerged) && now == 0) delete h;
+            else if (to_queue) enqueue(h);
+            return;
+        }
+    }
+}
+
+template<typename T>
+struct Block : Header {
+    T value;
+
+    template<typename... Args>
+    Block(std::uint64_t id, std::shared_ptr<MergeQueue> queue, Args&&... args)
+        : Header(id, std::move(queue)), value(std::forward<Args>(args)...) {}
+};
+
+} // namespace biased_detail
+
+template<typename T>
+class biased_ptr {
+private:
+    biased_detail::Block<T>* block = nullptr;
+
+    template<typename U, typename... Args>
+    friend biased_ptr<U> make_biased(Args&&... args);
+
+    explicit biased_ptr(biased_detail::Block<T>* b) : block(b) {}
+
+public:
+    biased_ptr() = default;
+    biased_ptr(std::nullptr_t) {}
+
+    biased_ptr(const biased_ptr& other) : block(other.block) {
+        if (block) biased_detail::increment(block);
+    }
+
+    biased_ptr(biased_ptr&& other) noexcept : block(other.block) { other.block = nullptr; }
+
+    biased_ptr& operator=(biased_ptr other) noexcept {
+        std::swap(block, other.block);
+        return *this;
+    }
+
+    ~biased_ptr() {
+        if (block) biased_detail::decrement(block);
+    }
+
+    void reset() { biased_ptr().swap(*this); }
+    void swap(biased_ptr& other) noexcept { std::swap(block, other.block); }
+
+    T* get() const { return block ? &block->value : nullptr; }
+    T& operator*() const { return block->value; }
+    T* operator->() const { return &block->value; }
+    explicit operator bool() const { return block != nullptr; }
+
+    // 转换为 std::shared_ptr：删除器持有一份 biased_ptr
+    std::shared_ptr<T> to_shared() const {
+        if (!block) return {};
+        return std::shared_ptr<T>(get(), [keep = *this](T*) mutable { keep.reset(); });
+    }
+};
+
+template<typename T, typename... Args>
+biased_ptr<T> make_biased(Args&&... args) {
+    auto& ctx = biased_detail::context();
+    biased_detail::process_pending();
+    return biased_ptr<T>(new biased_detail::Block<T>(ctx.id, ctx.queue, std::forward<Args>(args)...));
+}
+
+// owner 线程在空闲时调用，处理其他线程提交的合并请求
+inline void biased_poll() { biased_detail::process_pending(); }
+
+// 与 smart_pointers.cpp 的 Node 相同的父子结构，换成本地指针
+struct LocalNode {
+    std::string name;
+    local_shared_ptr<LocalNode> next;
+    local_weak_ptr<LocalNode> parent;
+
+    LocalNode(const std::string& n) : name(n) {
+        std::cout << "创建节点: " << name << "\n";
+    }
+
+    ~LocalNode() {
+        std::cout << "销毁节点: " << name << "\n";
+    }
+};
+
+void demonstrate_local_shared_ptr() {
+    std::cout << "\n=== local_shared_ptr ===\n";
+
+    {
+        auto parent = make_local_shared<LocalNode>("父节点");
+        auto child = make_local_shared<LocalNode>("子节点");
+
+        parent->next = child;
+        child->parent = parent;
+
+        std::cout << "父节点引用计数: " << parent.use_count() << "\n";
+        std::cout << "子节点引用计数: " << child.use_count() << "\n";
+
+        if (auto p = child->parent.lock()) {
+            std::cout << "子节点的父节点: " << p->name << "\n";
+        }
+
+        // 交给其他线程前先转换为 std::shared_ptr
+        std::shared_ptr<LocalNode> shared = child.to_shared();
+        std::thread worker([shared]() {
+            std::cout << "工作线程读取: " << shared->name << "\n";
+        });
+        worker.join();
+        std::cout << "转换后本地计数不变: " << child.use_count()
+                  << ", std::shared_ptr 计数: " << shared.use_count() << "\n";
+
+        // 本地指针全部释放后，对象仍由 std::shared_ptr 保持
+        local_weak_ptr<LocalNode> weak = child;
+        parent->next.reset();
+        child.reset();
+        std::cout << "本地强引用释放后 weak 是否过期: " << (weak.expired() ? "是" : "否") << "\n";
+        std::cout << "lock() 重新获得: " << weak.lock()->name << "\n";
+        shared.reset();
+        std::cout << "std::shared_ptr 释放后 weak 是否过期: " << (weak.expired() ? "是" : "否") << "\n";
+    }
+    std::cout << "作用域结束\n";
+
+    // 从 std::shared_ptr 转为本地指针
+    auto sp = std::make_shared<std::string>("来自 shared_ptr");
+    local_shared_ptr<std::string> lp(sp);
+    local_shared_ptr<std::string> lp2 = lp;
+    std::cout << *lp2 << ", 本地计数: " << lp.use_count() << ", shared_ptr 计数: " << sp.use_count() << "\n";
+}
+
+struct Tracked {
+    static std::atomic<int> live;
+    int value;
+    explicit Tracked(int v) : value(v) { ++live; }
+    ~Tracked() { --live; }
+};
+
+std::atomic<int> Tracked::live{0};
+
+void demonstrate_biased_ptr() {
+    std::cout << "\n=== biased_ptr ===\n";
+
+    {
+        auto p = make_biased<Tracked>(42);
+        auto q = p;  // owner 线程：非原子的偏向计数
+        std::cout << "owner 线程拷贝后值: " << q->value << ", 存活对象: " << Tracked::live << "\n";
+    }
+    std::cout << "owner 释放全部引用后存活对象: " << Tracked::live << "\n";
+
+    // owner 拷贝出的引用交给其他线程释放：共享计数变负，对象进入 owner 的合并队列
+    std::vector<biased_ptr<Tracked>> objects;
+    for (int i = 0; i < 1000; ++i) objects.push_back(make_biased<Tracked>(i));
+    std::vector<biased_ptr<Tracked>> handed = objects;  // owner 线程拷贝
+    objects.clear();                                    // owner 还剩 1 个偏向引用（在 handed 中）
+
+    long long sum = 0;
+    std::thread worker([&]() {
+        std::vector<biased_ptr<Tracked>> local = std::move(handed);
+        for (const auto& p : local) {
+            auto copy = p;  // 非 owner：原子的共享计数
+            sum += copy->value;
+        }
+    });
+    worker.join();
+    std::cout << "工作线程释放后、owner 合并前存活对象: " << Tracked::live << "\n";
+    biased_poll();
+    std::cout << "owner 处理合并队列后存活对象: " << Tracked::live << " (校验和 " << sum << ")\n";
+
+    // owner 线程先退出：非 owner 直接完成合并
+    biased_ptr<Tracked> orphan;
+    std::thread creator([&]() { orphan = make_biased<Tracked>(7); });
+    creator.join();
+    std::shared_ptr<Tracked> shared = orphan.to_shared();
+    orphan.reset();
+    std::cout << "owner 已退出, 通过 std::shared_ptr 访问: " << shared->value << "\n";
+    shared.reset();
+    std::cout << "全部释放后存活对象: " << Tracked::live << "\n";
+}
+
+// ===== 性能对比 =====
+template<template<typename> class Ptr>
+struct GraphNode {
+    int id;
+    std::vector<Ptr<GraphNode>> edges;
+    explicit GraphNode(int i) : id(i) {}
+};
+
+template<template<typename> class Ptr> struct NodeFactory;
+
+template<> struct NodeFactory<std::shared_ptr> {
+    static auto make(int id) { return std::make_shared<GraphNode<std::shared_ptr>>(id); }
+};
+template<> struct NodeFactory<local_shared_ptr> {
+    static auto make(int id) { return make_local_shared<GraphNode<local_shared_ptr>>(id); }
+};
+template<> struct NodeFactory<biased_ptr> {
+    static auto make(int id) { return make_biased<GraphNode<biased_ptr>>(id); }
+};
+
+// 建图：每个节点指向 4 个更早的节点（无环）；遍历：按值拷贝邻接表；最后整体销毁
+template<template<typename> class Ptr>
+void benchmark_graph(const std::string& label, int node_count) {
+    using Clock = std::chrono::high_resolution_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    std::mt19937 gen(1);
+    auto t0 = Clock::now();
+    std::vector<Ptr<GraphNode<Ptr>>> nodes;
+    nodes.reserve(node_count);
+    for (int i = 0; i < node_count; ++i) {
+        auto node = NodeFactory<Ptr>::make(i);
+        if (i > 0) {
+            node->edges.reserve(4);
+            for (int k = 0; k < 4; ++k) node->edges.push_back(nodes[gen() % i]);
+        }
+        nodes.push_back(std::move(node));
+    }
+    auto t1 = Clock::now();
+
+    long long sum = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (const auto& node : nodes) {
+            std::vector<Ptr<GraphNode<Ptr>>> neighbours = node->edges;
+            for (const auto& n : neighbours) sum += n->id;
+        }
+    }
+    auto t2 = Clock::now();
+
+    nodes.clear();
+    auto t3 = Clock::now();
+
+    std::cout << "   " << label << ": 建图 " << ms(t0, t1) << " ms, 拷贝遍历 "
+              << ms(t1, t2) << " ms, 销毁 " << ms(t2, t3) << " ms (校验 " << sum << ")\n";
+}
+
+void demonstrate_performance(int node_count) {
+    std::cout << "\n=== 建图性能对比 (" << node_count << " 个节点, 每个 4 条边) ===\n";
+
+    benchmark_graph<std::shared_ptr>("std::shared_ptr", node_count);
+    benchmark_graph<local_shared_ptr>("local_shared_ptr", node_count);
+    benchmark_graph<biased_ptr>("biased_ptr", node_count);
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "C++ Primer Chapter 12: 引用计数指针变体\n";
+    std::cout << "=================================\n";
+
+    try {
+        demonstrate_local_shared_ptr();
+        demonstrate_biased_ptr();
+
+        int nodes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+        demonstrate_performance(nodes);
+
+    } catch (const std::exception& e) {
+        std::cerr << "异常: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n程序执行完成！\n";
+    return 0;
+}
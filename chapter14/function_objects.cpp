@@ -9,6 +9,9 @@
 #include <functional>
 #include <string>
 #include <numeric>
+#include <chrono>
+#include "function_wrappers.h"
+#include "combinators.h"
 
 // 简单的函数对象
 class Add {
@@ -91,7 +94,7 @@ public:
 // 谓词函数对象
 class IsEven {
 public:
-    bool operator()(int x) const {
+    constexpr bool operator()(int x) const {
         return x % 2 == 0;
     }
 };
@@ -101,33 +104,40 @@ private:
     int min_val, max_val;
     
 public:
-    IsInRange(int min_v, int max_v) : min_val(min_v), max_val(max_v) {}
+    constexpr IsInRange(int min_v, int max_v) : min_val(min_v), max_val(max_v) {}
     
-    bool operator()(int x) const {
+    constexpr bool operator()(int x) const {
         return x >= min_val && x <= max_val;
     }
 };
 
 // 函数适配器示例
+// 被包装的函数对象存放在空基类优化的 ebo_storage 中（见 common/combinators.h），
+// 包装无状态谓词时适配器本身不占空间
 template<typename Func>
-class Negator {
+class Negator : private ebo_storage<Func, Negator<Func>, 0> {
 private:
-    Func func;
+    using Storage = ebo_storage<Func, Negator, 0>;
     
 public:
-    Negator(Func f) : func(f) {}
+    constexpr Negator(Func f) : Storage(std::move(f)) {}
     
     template<typename... Args>
-    auto operator()(Args&&... args) const -> decltype(!func(std::forward<Args>(args)...)) {
-        return !func(std::forward<Args>(args)...);
+    constexpr auto operator()(Args&&... args) const
+        -> decltype(!std::declval<const Func&>()(std::forward<Args>(args)...)) {
+        return !Storage::get()(std::forward<Args>(args)...);
     }
 };
 
 template<typename Func>
-Negator<Func> make_negator(Func f) {
-    return Negator<Func>(f);
+constexpr Negator<Func> make_negator(Func f) {
+    return Negator<Func>(std::move(f));
 }
 
+static_assert(sizeof(Negator<IsEven>) == 1, "包装无状态谓词不增加大小");
+static_assert(sizeof(Negator<IsInRange>) == sizeof(IsInRange), "只保存被包装对象的状态");
+static_assert(make_negator(IsEven())(3) && !make_negator(IsInRange(1, 5))(3), "可在编译期求值");
+
 void demonstrate_basic_function_objects() {
     std::cout << "\n=== 基本函数对象 ===\n";
     
@@ -258,6 +268,11 @@ void demonstrate_function_adapters() {
     auto is_odd = make_negator(is_even);
     int odd_count = std::count_if(numbers.begin(), numbers.end(), is_odd);
     std::cout << "奇数个数: " << odd_count << "\n";
+    std::cout << "sizeof(IsEven) = " << sizeof(is_even) << ", sizeof(make_negator(is_even)) = " << sizeof(is_odd) << "\n";
+    
+    // 适配器可与 compose 组合：先取模再判断奇偶
+    auto last_digit_odd = compose(make_negator(is_even), [](int x) { return x % 10; });
+    std::cout << "个位是奇数的个数: " << std::count_if(numbers.begin(), numbers.end(), last_digit_odd) << "\n";
     
     // 使用标准库的not_fn
     int odd_count2 = std::count_if(numbers.begin(), numbers.end(), 
@@ -300,6 +315,36 @@ void demonstrate_lambda_vs_function_objects() {
     std::cout << "Lambda 累积: " << sum << "\n";
 }
 
+bool is_even_function(int x) {
+    return x % 2 == 0;
+}
+
+// 四种传递谓词的方式；noinline 模拟谓词与算法位于不同编译单元
+template<typename Pred>
+long long count_with_template(const std::vector<int>& v, Pred pred) {
+    long long n = 0;
+    for (int x : v) n += pred(x);
+    return n;
+}
+
+__attribute__((noinline)) long long count_with_pointer(const std::vector<int>& v, bool (*pred)(int)) {
+    long long n = 0;
+    for (int x : v) n += pred(x);
+    return n;
+}
+
+__attribute__((noinline)) long long count_with_std_function(const std::vector<int>& v, const std::function<bool(int)>& pred) {
+    long long n = 0;
+    for (int x : v) n += pred(x);
+    return n;
+}
+
+__attribute__((noinline)) long long count_with_function_ref(const std::vector<int>& v, function_ref<bool(int)> pred) {
+    long long n = 0;
+    for (int x : v) n += pred(x);
+    return n;
+}
+
 void demonstrate_performance_considerations() {
     std::cout << "\n=== 性能考虑 ===\n";
     
@@ -308,11 +353,36 @@ void demonstrate_performance_considerations() {
     std::cout << "3. 避免在函数对象中进行昂贵的操作\n";
     std::cout << "4. 考虑使用 std::function 进行类型擦除时的开销\n";
     
-    // 展示 std::function 的使用
-    std::function<bool(int)> predicate = IsEven();
+    // 只在调用期间使用谓词时，function_ref 即可完成类型擦除：不拷贝、不分配。
+    // function_ref 不拥有对象，被引用的函数对象必须比它活得久，不能绑定到临时对象上
+    IsEven is_even;
+    function_ref<bool(int)> predicate = is_even;
     std::vector<int> test{2, 4, 6, 8};
     bool all_even = std::all_of(test.begin(), test.end(), predicate);
     std::cout << "所有数都是偶数: " << (all_even ? "true" : "false") << "\n";
+    
+    // 性能对比
+    std::vector<int> data(10000000);
+    std::iota(data.begin(), data.end(), 0);
+    
+    auto measure_time = [](const std::string& name, auto&& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        long long result = func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << name << ": " << duration.count() << " μs (结果 " << result << ")\n";
+    };
+    
+    std::cout << "统计 " << data.size() << " 个数中的偶数:\n";
+    measure_time("模板参数 IsEven", [&]() { return count_with_template(data, IsEven()); });
+    measure_time("函数指针", [&]() { return count_with_pointer(data, is_even_function); });
+    measure_time("std::function", [&]() { return count_with_std_function(data, IsEven()); });
+    measure_time("function_ref", [&]() { return count_with_function_ref(data, IsEven()); });
+    
+    std::cout << "统计奇数：适配器与手写循环\n";
+    measure_time("手写 x % 2 != 0", [&]() { return count_with_template(data, [](int x) { return x % 2 != 0; }); });
+    measure_time("make_negator(IsEven())", [&]() { return count_with_template(data, make_negator(IsEven())); });
+    measure_time("std::not_fn(IsEven())", [&]() { return count_with_template(data, std::not_fn(IsEven())); });
 }
 
 int main() {
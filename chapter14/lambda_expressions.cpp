@@ -10,6 +10,8 @@
 #include <string>
 #include <memory>
 #include <numeric>
+#include <chrono>
+#include "function_wrappers.h"
 
 void demonstrate_basic_lambdas() {
     std::cout << "\n=== 基本 Lambda 表达式 ===\n";
@@ -349,6 +351,62 @@ void demonstrate_lambda_performance() {
     };
     
     std::cout << "良好的捕获方式: " << good_lambda(0).substr(0, 10) << "...\n";
+    
+    // 示例：存储捕获型 lambda 的代价
+    // 捕获 4 个 double 和 1 个 int 的 lambda（40 字节）超出 std::function 的小对象缓冲区，每次构造都会分配堆内存；
+    // inplace_function 把它放在内部缓冲区，function_ref 只引用它
+    const int iterations = 1000000;
+    double a = 1.0, b = 2.0, c = 3.0, d = 4.0;
+    auto make_lambda = [&](int i) {
+        return [a, b, c, d, i](double x) { return ((a * x + b) * x + c) * x + d + i; };
+    };
+    std::cout << "捕获型 lambda 大小: " << sizeof(make_lambda(0)) << " 字节\n";
+    std::cout << "sizeof(std::function): " << sizeof(std::function<double(double)>)
+              << ", sizeof(inplace_function): " << sizeof(inplace_function<double(double), 48>)
+              << ", sizeof(function_ref): " << sizeof(function_ref<double(double)>) << "\n";
+    
+    auto measure_time = [](const std::string& name, auto&& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        double result = func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << name << ": " << duration.count() << " μs (结果 " << result << ")\n";
+    };
+    
+    std::cout << "构造并调用 " << iterations << " 次:\n";
+    measure_time("直接调用 lambda", [&]() {
+        double sum = 0;
+        for (int i = 0; i < iterations; ++i) {
+            auto f = make_lambda(i);
+            sum += f(0.5);
+        }
+        return sum;
+    });
+    measure_time("std::function", [&]() {
+        double sum = 0;
+        for (int i = 0; i < iterations; ++i) {
+            std::function<double(double)> f = make_lambda(i);
+            sum += f(0.5);
+        }
+        return sum;
+    });
+    measure_time("inplace_function", [&]() {
+        double sum = 0;
+        for (int i = 0; i < iterations; ++i) {
+            inplace_function<double(double), 48> f = make_lambda(i);
+            sum += f(0.5);
+        }
+        return sum;
+    });
+    measure_time("function_ref", [&]() {
+        double sum = 0;
+        for (int i = 0; i < iterations; ++i) {
+            auto lambda = make_lambda(i);
+            function_ref<double(double)> f = lambda;
+            sum += f(0.5);
+        }
+        return sum;
+    });
 }
 
 int main() {
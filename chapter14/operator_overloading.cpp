@@ -7,6 +7,20 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <chrono>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 // 复数类 - 演示算术运算符重载
 class Complex {
@@ -160,51 +174,169 @@ public:
     }
 };
 
+// 动态数组的存储策略：int 可以按字节搬移（trivially relocatable），
+// 所以扩容直接用 realloc，大块内存时 glibc 内部会用 mremap 免拷贝
+struct MallocAllocator {
+    static void* allocate(size_t bytes) {
+        void* p = std::malloc(bytes);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    static void* reallocate(void* p, size_t /*old_bytes*/, size_t new_bytes) {
+        void* q = std::realloc(p, new_bytes);
+        if (!q) throw std::bad_alloc();
+        return q;
+    }
+
+    static void deallocate(void* p, size_t /*bytes*/) {
+        std::free(p);
+    }
+};
+
+// 大页存储策略：起始地址与长度都按 2MB 对齐，并提示内核使用透明大页，扩容用 mremap
+// 适合元素数以千万计的数组，小数组会浪费内存
+struct HugePageAllocator {
+    static constexpr size_t kHugePage = 2 * 1024 * 1024;
+
+    static size_t round_up(size_t bytes) {
+        return (bytes + kHugePage - 1) & ~(kHugePage - 1);
+    }
+
+#if defined(__linux__)
+    // mmap 只保证 4KB 对齐：多映射 2MB，截取其中对齐的一段，再把首尾多余部分还给内核
+    static void* map_aligned(size_t bytes) {
+        size_t length = round_up(bytes);
+        void* raw = mmap(nullptr, length + kHugePage, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+        char* begin = static_cast<char*>(raw);
+        char* aligned = reinterpret_cast<char*>(
+            (reinterpret_cast<std::uintptr_t>(begin) + kHugePage - 1) & ~std::uintptr_t(kHugePage - 1));
+        if (aligned != begin) munmap(begin, aligned - begin);
+        size_t tail = (begin + length + kHugePage) - (aligned + length);
+        if (tail) munmap(aligned + length, tail);
+        return aligned;
+    }
+
+    static void* allocate(size_t bytes) {
+        void* p = map_aligned(bytes);
+        madvise(p, round_up(bytes), MADV_HUGEPAGE);
+        return p;
+    }
+
+    static void* reallocate(void* p, size_t old_bytes, size_t new_bytes) {
+        if (!p) return allocate(new_bytes);
+        size_t old_length = round_up(old_bytes), new_length = round_up(new_bytes);
+        if (old_length == new_length) return p;
+        // 先尝试原地伸缩，起始地址不变；不行再把旧页面整体搬到新的对齐区域开头，不复制数据
+        void* q = mremap(p, old_length, new_length, 0);
+        if (q == MAP_FAILED) {
+            void* target = map_aligned(new_bytes);
+            q = mremap(p, old_length, old_length, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+            if (q == MAP_FAILED) {
+                munmap(target, new_length);
+                throw std::bad_alloc();
+            }
+        }
+        madvise(q, new_length, MADV_HUGEPAGE);
+        return q;
+    }
+
+    static void deallocate(void* p, size_t bytes) {
+        if (p) munmap(p, round_up(bytes));
+    }
+#else
+    static void* allocate(size_t bytes) { return MallocAllocator::allocate(bytes); }
+    static void* reallocate(void* p, size_t old_bytes, size_t new_bytes) {
+        return MallocAllocator::reallocate(p, old_bytes, new_bytes);
+    }
+    static void deallocate(void* p, size_t bytes) { MallocAllocator::deallocate(p, bytes); }
+#endif
+};
+
 // 动态数组类 - 演示下标和比较运算符
-class DynamicArray {
+// 比较、填充、查找使用 SSE2 每次处理 4 个 int
+template<typename Allocator = MallocAllocator>
+class BasicDynamicArray {
 private:
     int* data;
     size_t size;
     size_t capacity;
     
+    // 按字节重新分配，不逐个拷贝元素
+    void reallocate(size_t new_capacity) {
+        if (new_capacity == 0) {
+            Allocator::deallocate(data, capacity * sizeof(int));
+            data = nullptr;
+        } else if (data == nullptr) {
+            data = static_cast<int*>(Allocator::allocate(new_capacity * sizeof(int)));
+        } else {
+            data = static_cast<int*>(Allocator::reallocate(
+                data, capacity * sizeof(int), new_capacity * sizeof(int)));
+        }
+        capacity = new_capacity;
+    }
+    
     void resize_if_needed() {
         if (size >= capacity) {
-            capacity = capacity == 0 ? 1 : capacity * 2;
-            int* new_data = new int[capacity];
-            for (size_t i = 0; i < size; ++i) {
-                new_data[i] = data[i];
-            }
-            delete[] data;
-            data = new_data;
+            reallocate(capacity == 0 ? 4 : capacity * 2);
         }
     }
     
 public:
-    DynamicArray() : data(nullptr), size(0), capacity(0) {}
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    BasicDynamicArray() : data(nullptr), size(0), capacity(0) {}
+    
+    BasicDynamicArray(size_t count, int value) : data(nullptr), size(0), capacity(0) {
+        reserve(count);
+        size = count;
+        fill(value);
+    }
     
-    ~DynamicArray() {
-        delete[] data;
+    ~BasicDynamicArray() {
+        if (data) Allocator::deallocate(data, capacity * sizeof(int));
     }
     
     // 拷贝构造函数
-    DynamicArray(const DynamicArray& other) 
-        : size(other.size), capacity(other.capacity) {
-        data = new int[capacity];
-        for (size_t i = 0; i < size; ++i) {
-            data[i] = other.data[i];
+    BasicDynamicArray(const BasicDynamicArray& other) 
+        : data(nullptr), size(0), capacity(0) {
+        reserve(other.size);
+        if (other.size > 0) std::memcpy(data, other.data, other.size * sizeof(int));
+        size = other.size;
+    }
+    
+    // 拷贝赋值运算符：容量足够时复用缓冲区
+    BasicDynamicArray& operator=(const BasicDynamicArray& other) {
+        if (this != &other) {
+            if (other.size > capacity) {
+                reserve(other.size);
+            }
+            if (other.size > 0) std::memcpy(data, other.data, other.size * sizeof(int));
+            size = other.size;
         }
+        return *this;
+    }
+    
+    // 移动构造函数
+    BasicDynamicArray(BasicDynamicArray&& other) noexcept
+        : data(other.data), size(other.size), capacity(other.capacity) {
+        other.data = nullptr;
+        other.size = 0;
+        other.capacity = 0;
     }
     
-    // 拷贝赋值运算符
-    DynamicArray& operator=(const DynamicArray& other) {
+    // 移动赋值运算符
+    BasicDynamicArray& operator=(BasicDynamicArray&& other) noexcept {
         if (this != &other) {
-            delete[] data;
+            if (data) Allocator::deallocate(data, capacity * sizeof(int));
+            data = other.data;
             size = other.size;
             capacity = other.capacity;
-            data = new int[capacity];
-            for (size_t i = 0; i < size; ++i) {
-                data[i] = other.data[i];
-            }
+            other.data = nullptr;
+            other.size = 0;
+            other.capacity = 0;
         }
         return *this;
     }
@@ -224,26 +356,89 @@ public:
         data[size++] = value;
     }
     
+    // 预留容量
+    void reserve(size_t new_capacity) {
+        if (new_capacity > capacity) {
+            reallocate(new_capacity);
+        }
+    }
+    
+    // 释放多余容量
+    void shrink_to_fit() {
+        if (capacity > size) {
+            reallocate(size);
+        }
+    }
+    
+    void clear() {
+        size = 0;
+    }
+    
     // 获取大小
     size_t get_size() const {
         return size;
     }
     
+    size_t get_capacity() const {
+        return capacity;
+    }
+    
+    // 所有元素置为 value
+    void fill(int value) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        __m128i v = _mm_set1_epi32(value);
+        for (; i + 4 <= size; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), v);
+        }
+#endif
+        for (; i < size; ++i) {
+            data[i] = value;
+        }
+    }
+    
+    // 查找第一个等于 value 的下标，未找到返回 npos
+    size_t find(int value) const {
+        size_t i = 0;
+#if defined(__SSE2__)
+        __m128i v = _mm_set1_epi32(value);
+        for (; i + 4 <= size; i += 4) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(chunk, v));
+            if (mask != 0) {
+                return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask))) / 4;
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            if (data[i] == value) return i;
+        }
+        return npos;
+    }
+    
     // 比较运算符
-    bool operator==(const DynamicArray& other) const {
+    bool operator==(const BasicDynamicArray& other) const {
         if (size != other.size) return false;
-        for (size_t i = 0; i < size; ++i) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        for (; i + 4 <= size; i += 4) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.data + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)) != 0xFFFF) return false;
+        }
+#endif
+        for (; i < size; ++i) {
             if (data[i] != other.data[i]) return false;
         }
         return true;
     }
     
-    bool operator!=(const DynamicArray& other) const {
+    bool operator!=(const BasicDynamicArray& other) const {
         return !(*this == other);
     }
     
     // 流插入运算符
-    friend std::ostream& operator<<(std::ostream& os, const DynamicArray& arr) {
+    friend std::ostream& operator<<(std::ostream& os, const BasicDynamicArray& arr) {
         os << "[";
         for (size_t i = 0; i < arr.size; ++i) {
             if (i > 0) os << ", ";
@@ -254,95 +449,215 @@ public:
     }
 };
 
+using DynamicArray = BasicDynamicArray<MallocAllocator>;
+using HugeDynamicArray = BasicDynamicArray<HugePageAllocator>;
+
 // 字符串类 - 演示各种运算符重载
+// 短字符串（不超过 15 个字符）直接存放在对象内部（SSO），不分配堆内存；
+// 长度随对象保存，比较和拼接都按长度操作而不依赖 '\0'
 class MyString {
 private:
-    char* data;
+    static constexpr size_t kInlineCapacity = 15;
+
+    char* data;   // 指向 inline_buf 或堆内存
     size_t len;
-    
+    union {
+        size_t cap;                          // 堆模式下的容量（不含 '\0'）
+        char inline_buf[kInlineCapacity + 1];
+    };
+
+    bool is_inline() const { return data == inline_buf; }
+    size_t capacity_() const { return is_inline() ? kInlineCapacity : cap; }
+
+    // 分配至少能容纳 n 个字符的存储，内容未初始化
+    void allocate(size_t n) {
+        if (n <= kInlineCapacity) {
+            data = inline_buf;
+        } else {
+            data = new char[n + 1];
+            cap = n;
+        }
+    }
+
+    void release() {
+        if (!is_inline()) delete[] data;
+    }
+
+    // 仅预留空间的构造，供 operator+ 一次性分配结果使用
+    struct ReserveTag {};
+    MyString(ReserveTag, size_t n) : len(0) {
+        allocate(n);
+        data[0] = '\0';
+    }
+
+    void assign(const char* str, size_t n) {
+        allocate(n);
+        std::memcpy(data, str, n);
+        data[n] = '\0';
+        len = n;
+    }
+
+    // 按长度比较：先比较公共前缀，再比较长度
+    int compare(const MyString& other) const {
+        size_t n = len < other.len ? len : other.len;
+        int r = n == 0 ? 0 : std::memcmp(data, other.data, n);
+        if (r != 0) return r;
+        if (len == other.len) return 0;
+        return len < other.len ? -1 : 1;
+    }
+
 public:
     MyString(const char* str = "") {
-        len = std::strlen(str);
-        data = new char[len + 1];
-        std::strcpy(data, str);
+        assign(str, std::strlen(str));
     }
-    
+
+    MyString(const char* str, size_t n) {
+        assign(str, n);
+    }
+
     ~MyString() {
-        delete[] data;
+        release();
     }
-    
+
     // 拷贝构造
-    MyString(const MyString& other) : len(other.len) {
-        data = new char[len + 1];
-        std::strcpy(data, other.data);
+    MyString(const MyString& other) {
+        assign(other.data, other.len);
     }
-    
-    // 拷贝赋值
+
+    // 移动构造：堆内存直接接管，内联内容按值拷贝
+    MyString(MyString&& other) noexcept : len(other.len) {
+        if (other.is_inline()) {
+            data = inline_buf;
+            std::memcpy(inline_buf, other.inline_buf, other.len + 1);
+        } else {
+            data = other.data;
+            cap = other.cap;
+        }
+        other.data = other.inline_buf;
+        other.len = 0;
+        other.inline_buf[0] = '\0';
+    }
+
+    // 拷贝赋值：容量足够时复用已有缓冲区
     MyString& operator=(const MyString& other) {
         if (this != &other) {
-            delete[] data;
+            if (other.len <= capacity_()) {
+                std::memcpy(data, other.data, other.len + 1);
+                len = other.len;
+            } else {
+                release();
+                assign(other.data, other.len);
+            }
+        }
+        return *this;
+    }
+
+    // 移动赋值
+    MyString& operator=(MyString&& other) noexcept {
+        if (this != &other) {
+            release();
             len = other.len;
-            data = new char[len + 1];
-            std::strcpy(data, other.data);
+            if (other.is_inline()) {
+                data = inline_buf;
+                std::memcpy(inline_buf, other.inline_buf, other.len + 1);
+            } else {
+                data = other.data;
+                cap = other.cap;
+            }
+            other.data = other.inline_buf;
+            other.len = 0;
+            other.inline_buf[0] = '\0';
         }
         return *this;
     }
-    
-    // 字符串连接
+
+    // 预留容量
+    void reserve(size_t n) {
+        if (n <= capacity_()) return;
+        char* new_data = new char[n + 1];
+        std::memcpy(new_data, data, len + 1);
+        release();
+        data = new_data;
+        cap = n;
+    }
+
+    // 字符串连接：结果只分配一次
     MyString operator+(const MyString& other) const {
-        MyString result;
+        MyString result(ReserveTag{}, len + other.len);
+        std::memcpy(result.data, data, len);
+        std::memcpy(result.data + len, other.data, other.len);
         result.len = len + other.len;
-        result.data = new char[result.len + 1];
-        std::strcpy(result.data, data);
-        std::strcat(result.data, other.data);
+        result.data[result.len] = '\0';
         return result;
     }
-    
-    // 复合赋值
+
+    // 复合赋值：容量按倍数增长，多次追加均摊 O(1)
     MyString& operator+=(const MyString& other) {
-        char* new_data = new char[len + other.len + 1];
-        std::strcpy(new_data, data);
-        std::strcat(new_data, other.data);
-        delete[] data;
-        data = new_data;
-        len += other.len;
+        size_t new_len = len + other.len;
+        if (new_len > capacity_()) {
+            size_t new_cap = capacity_() * 2;
+            if (new_cap < new_len) new_cap = new_len;
+            char* new_data = new char[new_cap + 1];
+            std::memcpy(new_data, data, len);
+            std::memcpy(new_data + len, other.data, other.len);  // other 可能就是 *this
+            release();
+            data = new_data;
+            cap = new_cap;
+        } else {
+            std::memcpy(data + len, other.data, other.len);
+        }
+        len = new_len;
+        data[len] = '\0';
         return *this;
     }
-    
+
     // 比较运算符
     bool operator==(const MyString& other) const {
-        return std::strcmp(data, other.data) == 0;
+        return len == other.len && (len == 0 || std::memcmp(data, other.data, len) == 0);
     }
-    
+
+    bool operator!=(const MyString& other) const {
+        return !(*this == other);
+    }
+
     bool operator<(const MyString& other) const {
-        return std::strcmp(data, other.data) < 0;
+        return compare(other) < 0;
     }
-    
+
     bool operator>(const MyString& other) const {
-        return std::strcmp(data, other.data) > 0;
+        return compare(other) > 0;
     }
-    
+
     // 下标运算符
     char& operator[](size_t index) {
         return data[index];
     }
-    
+
     const char& operator[](size_t index) const {
         return data[index];
     }
-    
+
     // 获取C字符串
     const char* c_str() const {
         return data;
     }
-    
+
     size_t length() const {
         return len;
     }
-    
+
+    size_t capacity() const {
+        return capacity_();
+    }
+
+    // 是否使用内联存储（未分配堆内存）
+    bool is_small() const {
+        return is_inline();
+    }
+
     // 流运算符
     friend std::ostream& operator<<(std::ostream& os, const MyString& str) {
-        os << str.data;
+        os.write(str.data, static_cast<std::streamsize>(str.len));
         return os;
     }
 };
@@ -426,6 +741,74 @@ void demonstrate_dynamic_array() {
     // 比较
     std::cout << "arr1 == arr2: " << (arr1 == arr2 ? "true" : "false") << "\n";
     std::cout << "arr1 != arr2: " << (arr1 != arr2 ? "true" : "false") << "\n";
+    
+    // 查找与填充
+    std::cout << "arr2.find(99) = " << arr2.find(99) << "\n";
+    std::cout << "arr2.find(42) == npos: " << (arr2.find(42) == DynamicArray::npos ? "true" : "false") << "\n";
+    arr2.fill(7);
+    std::cout << "arr2.fill(7): " << arr2 << "\n";
+    
+    // 容量管理
+    DynamicArray arr3;
+    arr3.reserve(100);
+    for (int i = 0; i < 10; ++i) arr3.push_back(i);
+    std::cout << "reserve(100) 后 push 10 个: size = " << arr3.get_size()
+              << ", capacity = " << arr3.get_capacity() << "\n";
+    arr3.shrink_to_fit();
+    std::cout << "shrink_to_fit 后: capacity = " << arr3.get_capacity() << "\n";
+    
+    // 移动语义
+    DynamicArray arr4 = std::move(arr3);
+    std::cout << "移动后: arr4 size = " << arr4.get_size()
+              << ", arr3 size = " << arr3.get_size() << "\n";
+}
+
+void demonstrate_dynamic_array_performance() {
+    std::cout << "\n=== DynamicArray 与 std::vector<int> 性能对比 ===\n";
+    
+    const size_t N = 20000000;
+    auto measure_time = [](auto func, const std::string& desc) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << desc << ": " << duration.count() << " μs\n";
+        return duration.count();
+    };
+    size_t check = 0;
+    
+    std::cout << "\npush_back " << N << " 个元素（realloc 扩容）:\n";
+    DynamicArray arr;
+    std::vector<int> vec;
+    HugeDynamicArray huge;
+    measure_time([&]() {
+        for (size_t i = 0; i < N; ++i) arr.push_back(static_cast<int>(i));
+    }, "DynamicArray");
+    measure_time([&]() {
+        for (size_t i = 0; i < N; ++i) huge.push_back(static_cast<int>(i));
+    }, "HugeDynamicArray (mmap/mremap)");
+    measure_time([&]() {
+        for (size_t i = 0; i < N; ++i) vec.push_back(static_cast<int>(i));
+    }, "std::vector");
+    
+    std::cout << "\n相等比较:\n";
+    DynamicArray arr_copy = arr;
+    std::vector<int> vec_copy = vec;
+    measure_time([&]() { check += (arr == arr_copy); }, "DynamicArray (SSE2)");
+    measure_time([&]() { check += (vec == vec_copy); }, "std::vector");
+    
+    std::cout << "\n查找末尾元素:\n";
+    int target = static_cast<int>(N - 1);
+    measure_time([&]() { check += arr.find(target); }, "DynamicArray (SSE2)");
+    measure_time([&]() {
+        check += static_cast<size_t>(std::find(vec.begin(), vec.end(), target) - vec.begin());
+    }, "std::find");
+    
+    std::cout << "\n填充:\n";
+    measure_time([&]() { arr.fill(3); check += arr[N / 2]; }, "DynamicArray (SSE2)");
+    measure_time([&]() { std::fill(vec.begin(), vec.end(), 3); check += vec[N / 2]; }, "std::fill");
+    
+    std::cout << "(校验值: " << check << ")\n";
 }
 
 void demonstrate_string_operators() {
@@ -458,6 +841,109 @@ void demonstrate_string_operators() {
     MyString str5("Apple");
     MyString str6("Banana");
     std::cout << "\"Apple\" < \"Banana\": " << (str5 < str6 ? "true" : "false") << "\n";
+    
+    // 短字符串优化
+    MyString short_str("short");
+    MyString long_str("this string is longer than fifteen chars");
+    std::cout << "\"short\" 使用内联存储: " << (short_str.is_small() ? "true" : "false") << "\n";
+    std::cout << "长字符串使用内联存储: " << (long_str.is_small() ? "true" : "false")
+              << ", capacity = " << long_str.capacity() << "\n";
+    
+    // 移动语义：长字符串直接转移堆内存
+    MyString moved = std::move(long_str);
+    std::cout << "移动后: moved = " << moved << ", 原对象长度 = " << long_str.length() << "\n";
+    
+    // += 按倍数扩容
+    MyString grow;
+    size_t last_cap = grow.capacity();
+    std::cout << "连续 += 时的容量变化: " << last_cap;
+    for (int i = 0; i < 40; ++i) {
+        grow += MyString("ab");
+        if (grow.capacity() != last_cap) {
+            last_cap = grow.capacity();
+            std::cout << " -> " << last_cap;
+        }
+    }
+    std::cout << "\n";
+}
+
+void demonstrate_string_performance() {
+    std::cout << "\n=== MyString 与 std::string 性能对比（短键） ===\n";
+    
+    const int N = 1000000;
+    auto measure_time = [](auto func, const std::string& desc) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << desc << ": " << duration.count() << " μs\n";
+        return duration.count();
+    };
+    
+    std::vector<std::string> raw_keys;
+    raw_keys.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        raw_keys.push_back("key" + std::to_string((i * 7919LL) % N));
+    }
+    size_t check = 0;
+    
+    std::cout << "\n构造 " << N << " 个短键:\n";
+    std::vector<MyString> my_keys;
+    std::vector<std::string> std_keys;
+    measure_time([&]() {
+        my_keys.reserve(N);
+        for (const auto& k : raw_keys) my_keys.emplace_back(k.c_str(), k.size());
+    }, "MyString");
+    measure_time([&]() {
+        std_keys.reserve(N);
+        for (const auto& k : raw_keys) std_keys.emplace_back(k);
+    }, "std::string");
+    
+    std::cout << "\n拷贝:\n";
+    measure_time([&]() {
+        std::vector<MyString> copy = my_keys;
+        check += copy.size();
+    }, "MyString");
+    measure_time([&]() {
+        std::vector<std::string> copy = std_keys;
+        check += copy.size();
+    }, "std::string");
+    
+    std::cout << "\n排序（比较 + 移动）:\n";
+    measure_time([&]() {
+        std::sort(my_keys.begin(), my_keys.end());
+    }, "MyString");
+    measure_time([&]() {
+        std::sort(std_keys.begin(), std_keys.end());
+    }, "std::string");
+    
+    std::cout << "\n相等查找:\n";
+    measure_time([&]() {
+        MyString probe("key4242");
+        for (const auto& k : my_keys) check += (k == probe);
+    }, "MyString");
+    measure_time([&]() {
+        std::string probe("key4242");
+        for (const auto& k : std_keys) check += (k == probe);
+    }, "std::string");
+    
+    std::cout << "\n拼接（+ 与 +=）:\n";
+    measure_time([&]() {
+        MyString suffix("_v2");
+        for (const auto& k : my_keys) check += (k + suffix).length();
+        MyString all;
+        for (int i = 0; i < N; ++i) all += suffix;
+        check += all.length();
+    }, "MyString");
+    measure_time([&]() {
+        std::string suffix("_v2");
+        for (const auto& k : std_keys) check += (k + suffix).length();
+        std::string all;
+        for (int i = 0; i < N; ++i) all += suffix;
+        check += all.length();
+    }, "std::string");
+    
+    std::cout << "(校验值: " << check << ")\n";
 }
 
 void demonstrate_operator_guidelines() {
@@ -483,7 +969,9 @@ int main() {
         demonstrate_complex_operators();
         demonstrate_smart_pointer();
         demonstrate_dynamic_array();
+        demonstrate_dynamic_array_performance();
         demonstrate_string_operators();
+        demonstrate_string_performance();
         demonstrate_operator_guidelines();
         
     } catch (const std::exception& e) {
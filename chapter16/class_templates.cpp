@@ -6,8 +6,22 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <initializer_list>
+#include <utility>
 #include <memory>
 #include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // 基础类模板
 template<typename T>
@@ -70,16 +84,226 @@ std::ostream& operator<<(std::ostream& os, const Stack<T>& stack) {
     return os;
 }
 
-// 类模板特化
+// 位向量：按 64 位字存储，最后一个字中超出 size() 的位始终保持为 0，
+// 因此 popcount、查找和按位运算都可以整字处理而无需特判尾部
+class BitVector {
+public:
+    using word_type = std::uint64_t;
+    static constexpr size_t word_bits = 64;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    std::vector<word_type> words;
+    size_t bit_count = 0;
+
+    static size_t words_for(size_t bits) { return (bits + word_bits - 1) / word_bits; }
+
+    static word_type low_mask(size_t n) {
+        return n >= word_bits ? ~word_type(0) : (word_type(1) << n) - 1;
+    }
+
+    void clear_tail() {
+        if (bit_count % word_bits) {
+            words.back() &= low_mask(bit_count % word_bits);
+        }
+    }
+
+    void check_same_size(const BitVector& other) const {
+        if (bit_count != other.bit_count) {
+            throw std::invalid_argument("位向量长度不一致");
+        }
+    }
+
+    enum class BitOp { And, Or, Xor };
+
+    template<BitOp Op>
+    static void combine_words(word_type* dst, const word_type* src, size_t n) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        for (; i + 2 <= n; i += 2) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i r;
+            if constexpr (Op == BitOp::And) r = _mm_and_si128(a, b);
+            else if constexpr (Op == BitOp::Or) r = _mm_or_si128(a, b);
+            else r = _mm_xor_si128(a, b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+        }
+#endif
+        for (; i < n; ++i) {
+            if constexpr (Op == BitOp::And) dst[i] &= src[i];
+            else if constexpr (Op == BitOp::Or) dst[i] |= src[i];
+            else dst[i] ^= src[i];
+        }
+    }
+
+    static size_t popcount_generic(const word_type* w, size_t n) {
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i) total += __builtin_popcountll(w[i]);
+        return total;
+    }
+
+#if defined(__GNUC__) && defined(__x86_64__)
+    // 默认编译选项不启用 POPCNT 指令，这里单独为它编译一份，运行时按 CPU 支持情况选择
+    __attribute__((target("popcnt")))
+    static size_t popcount_hw(const word_type* w, size_t n) {
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i) total += __builtin_popcountll(w[i]);
+        return total;
+    }
+#endif
+
+    static size_t popcount_words(const word_type* w, size_t n) {
+#if defined(__GNUC__) && defined(__x86_64__)
+        static const bool has_popcnt = __builtin_cpu_supports("popcnt");
+        if (has_popcnt) return popcount_hw(w, n);
+#endif
+        return popcount_generic(w, n);
+    }
+
+public:
+    BitVector() = default;
+
+    BitVector(size_t n, bool value)
+        : words(words_for(n), value ? ~word_type(0) : word_type(0)), bit_count(n) {
+        clear_tail();
+    }
+
+    size_t size() const { return bit_count; }
+    bool empty() const { return bit_count == 0; }
+    void reserve(size_t bits) { words.reserve(words_for(bits)); }
+    void clear() { words.clear(); bit_count = 0; }
+
+    const word_type* data() const { return words.data(); }
+    size_t word_count() const { return words.size(); }
+
+    bool operator[](size_t i) const {
+        return (words[i / word_bits] >> (i % word_bits)) & 1;
+    }
+
+    void set(size_t i, bool value) {
+        word_type mask = word_type(1) << (i % word_bits);
+        if (value) words[i / word_bits] |= mask;
+        else words[i / word_bits] &= ~mask;
+    }
+
+    bool back() const { return (*this)[bit_count - 1]; }
+
+    void push_back(bool value) {
+        if (bit_count % word_bits == 0) words.push_back(0);
+        words.back() |= word_type(value) << (bit_count % word_bits);
+        ++bit_count;
+    }
+
+    void pop_back() {
+        --bit_count;
+        if (bit_count % word_bits == 0) {
+            words.pop_back();
+        } else {
+            words.back() &= ~(word_type(1) << (bit_count % word_bits));
+        }
+    }
+
+    // 追加 count 个相同的位
+    void append(size_t count, bool value) {
+        size_t shift = bit_count % word_bits;
+        if (shift && count) {
+            size_t take = std::min(count, word_bits - shift);
+            if (value) words.back() |= low_mask(take) << shift;
+            bit_count += take;
+            count -= take;
+        }
+        words.resize(words.size() + words_for(count), value ? ~word_type(0) : word_type(0));
+        bit_count += count;
+        clear_tail();
+    }
+
+    // 追加 src 中的 count 位（从 src[0] 的最低位开始），按字移位拼接
+    void append_bits(const word_type* src, size_t count) {
+        size_t shift = bit_count % word_bits;
+        size_t full = count / word_bits;
+        size_t rest = count % word_bits;
+        words.reserve(words_for(bit_count + count));
+        if (shift == 0) {
+            words.insert(words.end(), src, src + full);
+            if (rest) words.push_back(src[full] & low_mask(rest));
+        } else {
+            for (size_t i = 0; i < full; ++i) {
+                words.back() |= src[i] << shift;
+                words.push_back(src[i] >> (word_bits - shift));
+            }
+            if (rest) {
+                word_type w = src[full] & low_mask(rest);
+                words.back() |= w << shift;
+                if (shift + rest > word_bits) words.push_back(w >> (word_bits - shift));
+            }
+        }
+        bit_count += count;
+    }
+
+    size_t count() const { return popcount_words(words.data(), words.size()); }
+
+    // 下标 >= pos 的第一个 1，不存在时返回 npos
+    size_t find_next(size_t pos) const {
+        if (pos >= bit_count) return npos;
+        size_t w = pos / word_bits;
+        word_type cur = words[w] & (~word_type(0) << (pos % word_bits));
+        while (true) {
+            if (cur) return w * word_bits + __builtin_ctzll(cur);
+            if (++w == words.size()) return npos;
+            cur = words[w];
+        }
+    }
+
+    size_t find_first() const { return find_next(0); }
+
+    // 下标最大的 1
+    size_t find_last() const {
+        for (size_t w = words.size(); w-- > 0;) {
+            if (words[w]) return w * word_bits + (word_bits - 1 - __builtin_clzll(words[w]));
+        }
+        return npos;
+    }
+
+    BitVector& operator&=(const BitVector& other) {
+        check_same_size(other);
+        combine_words<BitOp::And>(words.data(), other.words.data(), words.size());
+        return *this;
+    }
+
+    BitVector& operator|=(const BitVector& other) {
+        check_same_size(other);
+        combine_words<BitOp::Or>(words.data(), other.words.data(), words.size());
+        return *this;
+    }
+
+    BitVector& operator^=(const BitVector& other) {
+        check_same_size(other);
+        combine_words<BitOp::Xor>(words.data(), other.words.data(), words.size());
+        return *this;
+    }
+};
+
+// 类模板特化：bool 栈按位存储，栈底是下标 0
 template<>
 class Stack<bool> {
 private:
-    std::vector<bool> data;
+    BitVector data;
     
 public:
+    static constexpr size_t npos = BitVector::npos;
+
     void push(bool item) {
         data.push_back(item);
-        std::cout << "bool特化压入: " << std::boolalpha << item << "\n";
+    }
+    
+    // 批量压入：bits 中的 count 位从最低位开始依次入栈
+    void push_bits(const std::uint64_t* bits, size_t count) {
+        data.append_bits(bits, count);
+    }
+    
+    void push_n(size_t count, bool item) {
+        data.append(count, item);
     }
     
     bool pop() {
@@ -88,7 +312,6 @@ public:
         }
         bool item = data.back();
         data.pop_back();
-        std::cout << "bool特化弹出: " << std::boolalpha << item << "\n";
         return item;
     }
     
@@ -106,46 +329,163 @@ public:
     size_t size() const {
         return data.size();
     }
+    
+    // 栈中 true 的个数
+    size_t count() const {
+        return data.count();
+    }
+    
+    // 离栈底 / 栈顶最近的 true 的位置（从栈底数起），没有时返回 npos
+    size_t find_first() const {
+        return data.find_first();
+    }
+    
+    size_t find_last() const {
+        return data.find_last();
+    }
+    
+    // 两个等高的栈逐位与/或
+    Stack& operator&=(const Stack& other) {
+        data &= other.data;
+        return *this;
+    }
+    
+    Stack& operator|=(const Stack& other) {
+        data |= other.data;
+        return *this;
+    }
+    
+    const BitVector& bits() const {
+        return data;
+    }
+};
+
+// SimpleMap 使用的哈希：整数和 string_view 的版本是 constexpr 的，可以在编译期建表
+template<typename K, typename = void>
+struct SimpleMapHash {
+    size_t operator()(const K& key) const { return std::hash<K>{}(key); }
+};
+
+template<typename K>
+struct SimpleMapHash<K, std::enable_if_t<std::is_integral<K>::value || std::is_enum<K>::value>> {
+    constexpr size_t operator()(K key) const { return static_cast<size_t>(key); }
+};
+
+template<>
+struct SimpleMapHash<std::string_view> {
+    constexpr size_t operator()(std::string_view key) const {
+        std::uint64_t h = 14695981039346656037ULL;  // FNV-1a
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h);
+    }
 };
 
 // 多个模板参数的类模板
+// 固定容量的开放寻址（线性探测）哈希表：
+// - 槽位数是编译期由 MaxSize 推出的 2 的幂，负载因子不超过 1/2，取模变为按位与
+// - 键、值、占用标记分别存放（SoA），探测时只读取键数组
+// - 所有操作都是 constexpr，键值为字面类型时整张表可在编译期构建
 template<typename K, typename V, size_t MaxSize = 100>
 class SimpleMap {
 private:
-    std::pair<K, V> data[MaxSize];
-    size_t current_size;
+    static constexpr size_t next_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
     
 public:
-    SimpleMap() : current_size(0) {}
+    static constexpr size_t table_size = next_pow2(MaxSize * 2);
+    
+private:
+    static constexpr size_t mask = table_size - 1;
+    
+    K keys[table_size]{};
+    V values[table_size]{};
+    bool used[table_size]{};
+    size_t current_size = 0;
+    
+    // 打散低质量哈希（如整数的恒等哈希）后再取低位
+    static constexpr size_t slot_of(const K& key) {
+        std::uint64_t h = static_cast<std::uint64_t>(SimpleMapHash<K>{}(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h) & mask;
+    }
     
-    bool insert(const K& key, const V& value) {
-        if (current_size >= MaxSize) {
-            return false;
+    // 返回 key 所在槽位，或探测序列上第一个空槽
+    constexpr size_t probe(const K& key) const {
+        size_t i = slot_of(key);
+        while (used[i] && !(keys[i] == key)) {
+            i = (i + 1) & mask;
         }
-        data[current_size++] = std::make_pair(key, value);
-        return true;
+        return i;
     }
     
-    V* find(const K& key) {
-        for (size_t i = 0; i < current_size; ++i) {
-            if (data[i].first == key) {
-                return &data[i].second;
+public:
+    constexpr SimpleMap() = default;
+    
+    constexpr SimpleMap(std::initializer_list<std::pair<K, V>> init) {
+        for (const auto& kv : init) {
+            insert(kv.first, kv.second);
+        }
+    }
+    
+    // 插入新键或更新已有键；表满时返回 false
+    constexpr bool insert(const K& key, const V& value) {
+        size_t i = probe(key);
+        if (!used[i]) {
+            if (current_size >= MaxSize) {
+                return false;
             }
+            used[i] = true;
+            keys[i] = key;
+            ++current_size;
         }
-        return nullptr;
+        values[i] = value;
+        return true;
+    }
+    
+    constexpr V* find(const K& key) {
+        size_t i = probe(key);
+        return used[i] ? &values[i] : nullptr;
+    }
+    
+    constexpr const V* find(const K& key) const {
+        size_t i = probe(key);
+        return used[i] ? &values[i] : nullptr;
     }
     
-    size_t size() const { return current_size; }
-    size_t capacity() const { return MaxSize; }
+    constexpr bool contains(const K& key) const { return used[probe(key)]; }
+    
+    constexpr size_t size() const { return current_size; }
+    constexpr size_t capacity() const { return MaxSize; }
     
+    // 按槽位顺序输出，与插入顺序无关
     void display() const {
-        std::cout << "SimpleMap (" << current_size << "/" << MaxSize << "):\n";
-        for (size_t i = 0; i < current_size; ++i) {
-            std::cout << "  " << data[i].first << " -> " << data[i].second << "\n";
+        std::cout << "SimpleMap (" << current_size << "/" << MaxSize
+                  << ", " << table_size << " 槽):\n";
+        for (size_t i = 0; i < table_size; ++i) {
+            if (used[i]) {
+                std::cout << "  " << keys[i] << " -> " << values[i] << "\n";
+            }
         }
     }
 };
 
+// 编译期构建的查找表
+constexpr SimpleMap<int, std::string_view, 8> http_status_table{
+    {200, "OK"}, {301, "Moved Permanently"}, {404, "Not Found"}, {500, "Internal Server Error"}
+};
+
+static_assert(http_status_table.size() == 4, "编译期插入 4 项");
+static_assert(*http_status_table.find(404) == "Not Found", "编译期查找");
+static_assert(http_status_table.find(418) == nullptr, "不存在的键");
+
 // 成员模板
 template<typename T>
 class Container {
@@ -265,6 +605,8 @@ public:
     static constexpr size_t size() { return 1 + sizeof...(Tail); }
 
 private:
+    template<typename...> friend class Tuple;
+    
     void print_tail() const {
         if constexpr (sizeof...(Tail) > 0) {
             std::cout << ", ";
@@ -363,9 +705,95 @@ void demonstrate_class_template_specialization() {
     
     std::cout << "bool栈大小: " << bool_stack.size() << "\n";
     
+    std::cout << "依次弹出:";
     while (!bool_stack.empty()) {
-        bool_stack.pop();
+        std::cout << " " << std::boolalpha << bool_stack.pop();
+    }
+    std::cout << "\n";
+    
+    // 按字批量操作
+    std::uint64_t pattern[2] = {0xF0F0F0F0F0F0F0F0ULL, 0x1ULL};
+    Stack<bool> a;
+    a.push_n(3, false);
+    a.push_bits(pattern, 65);   // 跨字边界拼接
+    std::cout << "批量压入后大小: " << a.size() << ", true 的个数: " << a.count()
+              << ", 第一个 true 位置: " << a.find_first()
+              << ", 最后一个 true 位置: " << a.find_last() << "\n";
+    
+    Stack<bool> b;
+    b.push_n(a.size(), true);
+    b.pop();
+    b.push(false);
+    a &= b;
+    std::cout << "与栈顶为 false 的全 1 栈按位与后, 栈顶: " << a.top()
+              << ", true 的个数: " << a.count() << "\n";
+}
+
+void demonstrate_bit_stack_performance(size_t bits) {
+    std::cout << "\n=== Stack<bool> 与 vector<bool> 性能对比 (" << bits << " 位) ===\n";
+    
+    auto measure_time = [](auto func, const std::string& desc) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "   " << desc << ": " << duration.count() << " μs\n";
+    };
+    
+    std::mt19937_64 gen(42);
+    std::vector<std::uint64_t> source((bits + 63) / 64);
+    for (auto& w : source) w = gen() & gen();   // 约 1/4 的位为 1
+    size_t check = 0;
+    
+    std::cout << "\n逐位压入:\n";
+    {
+        std::vector<bool> vb;
+        Stack<bool> sb;
+        measure_time([&]() {
+            for (size_t i = 0; i < bits; ++i) vb.push_back(i % 3 == 0);
+        }, "vector<bool>::push_back");
+        measure_time([&]() {
+            for (size_t i = 0; i < bits; ++i) sb.push(i % 3 == 0);
+        }, "Stack<bool>::push");
+        check += vb.size() + sb.size();
     }
+    
+    std::vector<bool> va, vb;
+    Stack<bool> sa, sb;
+    std::cout << "\n批量压入 (来自 64 位字数组):\n";
+    measure_time([&]() {
+        va.reserve(bits);
+        for (size_t i = 0; i < bits; ++i) va.push_back((source[i / 64] >> (i % 64)) & 1);
+    }, "vector<bool> 逐位拆分");
+    measure_time([&]() { sa.push_bits(source.data(), bits); }, "Stack<bool>::push_bits");
+    
+    vb.assign(bits, true);
+    sb.push_n(bits, true);
+    
+    std::cout << "\n统计 true 的个数:\n";
+    measure_time([&]() { check += std::count(va.begin(), va.end(), true); }, "std::count(vector<bool>)");
+    measure_time([&]() { check += sa.count(); }, "Stack<bool>::count (popcount)");
+    
+    std::cout << "\n整栈按位与:\n";
+    measure_time([&]() {
+        for (size_t i = 0; i < bits; ++i) vb[i] = vb[i] && va[i];
+    }, "vector<bool> 逐位");
+    measure_time([&]() { sb &= sa; }, "Stack<bool>::operator&= (SIMD)");
+    check += (sb.count() == sa.count());
+    
+    std::cout << "\n稀疏位查找 (只有最后一位为 true):\n";
+    std::vector<bool> sparse_v(bits, false);
+    Stack<bool> sparse_s;
+    sparse_s.push_n(bits, false);
+    sparse_v.back() = true;
+    sparse_s.pop();
+    sparse_s.push(true);
+    measure_time([&]() {
+        check += std::find(sparse_v.begin(), sparse_v.end(), true) - sparse_v.begin();
+    }, "std::find(vector<bool>)");
+    measure_time([&]() { check += sparse_s.find_first(); }, "Stack<bool>::find_first (ctz)");
+    
+    std::cout << "   (校验值: " << check << ")\n";
 }
 
 void demonstrate_multiple_template_parameters() {
@@ -387,6 +815,80 @@ void demonstrate_multiple_template_parameters() {
     SimpleMap<int, std::string> large_map;
     large_map.insert(100, "hundred");
     large_map.display();
+    
+    // 编译期建好的表，运行时直接查询
+    std::cout << "编译期状态码表: 404 -> " << *http_status_table.find(404)
+              << ", 槽位数: " << http_status_table.table_size << "\n";
+    
+    constexpr SimpleMap<std::string_view, int, 4> keywords{{"if", 1}, {"for", 2}, {"while", 3}};
+    static_assert(*keywords.find("for") == 2, "string_view 键也可在编译期查找");
+    std::cout << "编译期关键字表: while -> " << *keywords.find("while") << "\n";
+}
+
+// 在 MaxSize 个整数键中查找，一半命中一半未命中
+template<size_t MaxSize>
+void benchmark_simple_map_lookup() {
+    using Clock = std::chrono::high_resolution_clock;
+    
+    auto map = std::make_unique<SimpleMap<int, int, MaxSize>>();
+    std::vector<std::pair<int, int>> linear;
+    std::unordered_map<int, int> hashed;
+    for (size_t i = 0; i < MaxSize; ++i) {
+        int key = static_cast<int>(i * 2);
+        map->insert(key, static_cast<int>(i));
+        linear.emplace_back(key, static_cast<int>(i));
+        hashed.emplace(key, static_cast<int>(i));
+    }
+    
+    std::mt19937 gen(7);
+    std::vector<int> queries(1 << 16);
+    for (auto& q : queries) q = static_cast<int>(gen() % (MaxSize * 2));
+    
+    auto ns_per_lookup = [&](size_t lookups, auto&& lookup) {
+        long long found = 0;
+        auto start = Clock::now();
+        for (size_t i = 0; i < lookups; ++i) {
+            found += lookup(queries[i & (queries.size() - 1)]);
+        }
+        auto end = Clock::now();
+        volatile long long sink = found;
+        (void)sink;
+        return std::chrono::duration<double, std::nano>(end - start).count() / lookups;
+    };
+    
+    const size_t lookups = 1 << 22;
+    // 线性查找的总工作量随 MaxSize 增长，减少次数以控制耗时
+    const size_t linear_lookups = std::max<size_t>(1024, (size_t(1) << 26) / MaxSize);
+    
+    double t_map = ns_per_lookup(lookups, [&](int k) {
+        const int* v = map->find(k);
+        return v ? *v : 0;
+    });
+    double t_hashed = ns_per_lookup(lookups, [&](int k) {
+        auto it = hashed.find(k);
+        return it != hashed.end() ? it->second : 0;
+    });
+    double t_linear = ns_per_lookup(linear_lookups, [&](int k) {
+        auto it = std::find_if(linear.begin(), linear.end(),
+                               [k](const std::pair<int, int>& kv) { return kv.first == k; });
+        return it != linear.end() ? it->second : 0;
+    });
+    
+    std::cout << "   MaxSize=" << MaxSize << ": SimpleMap " << t_map
+              << " ns, unordered_map " << t_hashed
+              << " ns, 线性查找 " << t_linear << " ns\n";
+}
+
+void demonstrate_simple_map_performance() {
+    std::cout << "\n=== SimpleMap 查找性能 (每次查找耗时) ===\n";
+    
+    benchmark_simple_map_lookup<16>();
+    benchmark_simple_map_lookup<64>();
+    benchmark_simple_map_lookup<256>();
+    benchmark_simple_map_lookup<1024>();
+    benchmark_simple_map_lookup<4096>();
+    benchmark_simple_map_lookup<16384>();
+    benchmark_simple_map_lookup<65536>();
 }
 
 void demonstrate_member_templates() {
@@ -513,7 +1015,7 @@ void demonstrate_template_guidelines() {
     std::cout << "   - 避免不必要的代码膨胀\n";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "C++ Primer Chapter 16: 类模板演示\n";
     std::cout << "===============================\n";
     
@@ -529,6 +1031,11 @@ int main() {
         demonstrate_template_metaprogramming();
         demonstrate_template_guidelines();
         
+        // 默认 6400 万位；传入 1000000000 可运行 10 亿位的测试（约需 1GB 内存）
+        size_t bits = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 26);
+        demonstrate_bit_stack_performance(bits);
+        demonstrate_simple_map_performance();
+        
     } catch (const std::exception& e) {
         std::cerr << "异常: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,93 @@
+#ifndef COMBINATORS_H
+#define COMBINATORS_H
+
+// 编译期函数组合器：compose 与 curry
+// - 结果是普通的类模板对象而非层层嵌套的 lambda，全部成员函数为 constexpr，
+//   可以在常量表达式中求值，调用时编译器能完整内联
+// - 被包装的可调用对象通过 ebo_storage 保存：空类型（无捕获 lambda、无状态仿函数）
+//   作为基类存放，不占空间，组合结果的大小等于其中真正的状态之和
+//   （同一个空类型出现多次时，语言要求各个子对象地址不同，每多一次占 1 字节）
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// 空基类优化存储。Owner 与 Index 使每个 ebo_storage 基类的类型唯一，
+// 即使 compose(f, f, f) 这样同一类型在嵌套中出现多次，get() 也不会有歧义
+template<typename T, typename Owner, int Index, bool = std::is_empty_v<T> && !std::is_final_v<T>>
+class ebo_storage {
+private:
+    T value;
+
+public:
+    constexpr explicit ebo_storage(T v) : value(std::move(v)) {}
+    constexpr const T& get() const { return value; }
+};
+
+template<typename T, typename Owner, int Index>
+class ebo_storage<T, Owner, Index, true> : private T {
+public:
+    constexpr explicit ebo_storage(T v) : T(std::move(v)) {}
+    constexpr const T& get() const { return *this; }
+};
+
+// compose(f, g)(x...) == f(g(x...))
+template<typename F, typename G>
+class Composed : private ebo_storage<F, Composed<F, G>, 0>, private ebo_storage<G, Composed<F, G>, 1> {
+private:
+    using Outer = ebo_storage<F, Composed, 0>;
+    using Inner = ebo_storage<G, Composed, 1>;
+
+public:
+    constexpr Composed(F f, G g) : Outer(std::move(f)), Inner(std::move(g)) {}
+
+    template<typename... Args>
+    constexpr decltype(auto) operator()(Args&&... args) const {
+        return Outer::get()(Inner::get()(std::forward<Args>(args)...));
+    }
+};
+
+template<typename F>
+constexpr F compose(F f) {
+    return f;
+}
+
+// compose(f, g, h)(x) == f(g(h(x)))
+template<typename F, typename G, typename... Rest>
+constexpr auto compose(F f, G g, Rest... rest) {
+    auto inner = compose(std::move(g), std::move(rest)...);
+    return Composed<F, decltype(inner)>(std::move(f), std::move(inner));
+}
+
+// curry(f)(a)(b)(c) == f(a, b, c)；一次也可以传多个参数，如 curry(f)(a, b)(c)。
+// 参数足以调用 f 时立即调用，否则按值保存已绑定的参数并返回新的 Curried
+template<typename F, typename... Bound>
+class Curried : private ebo_storage<F, Curried<F, Bound...>, 0>,
+                private ebo_storage<std::tuple<Bound...>, Curried<F, Bound...>, 1> {
+private:
+    using Func = ebo_storage<F, Curried, 0>;
+    using Args = ebo_storage<std::tuple<Bound...>, Curried, 1>;
+
+public:
+    constexpr Curried(F f, std::tuple<Bound...> bound) : Func(std::move(f)), Args(std::move(bound)) {}
+
+    template<typename... Next>
+    constexpr auto operator()(Next&&... next) const {
+        if constexpr (std::is_invocable_v<const F&, const Bound&..., Next...>) {
+            return std::apply([&](const Bound&... bound) {
+                return Func::get()(bound..., std::forward<Next>(next)...);
+            }, Args::get());
+        } else {
+            return Curried<F, Bound..., std::decay_t<Next>...>(
+                Func::get(),
+                std::tuple_cat(Args::get(), std::tuple<std::decay_t<Next>...>(std::forward<Next>(next)...)));
+        }
+    }
+};
+
+template<typename F>
+constexpr auto curry(F f) {
+    return Curried<F>(std::move(f), std::tuple<>());
+}
+
+#endif // COMBINATORS_H
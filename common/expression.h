@@ -0,0 +1,421 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+// 批量表达式求值
+// - 表达式只解析一次，编译成紧凑的寄存器字节码；解析时做常量折叠，
+//   生成代码时把相邻的 乘+加、乘+减 融合成一条 mul_add / mul_sub 指令
+// - 按列求值：每批 kBatchSize 行，每条指令只分派一次就处理整批，
+//   内层是没有分支的简单循环，可以被编译器向量化
+// - 常量在编译时广播成一整批，所有指令的操作数统一是"一段连续的 double"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+enum class ExprOp : uint8_t {
+    COPY,     // dst = a
+    NEG,      // dst = -a
+    ADD,      // dst = a + b
+    SUB,      // dst = a - b
+    MUL,      // dst = a * b
+    DIV,      // dst = a / b
+    MUL_ADD,  // dst = a * b + c
+    MUL_SUB   // dst = a * b - c
+};
+
+// 操作数来源：输入列、广播常量、临时寄存器、输出列
+struct ExprOperand {
+    enum Kind : uint8_t { COLUMN, CONSTANT, TEMP, OUTPUT };
+    Kind kind;
+    uint16_t index;
+};
+
+struct ExprInstruction {
+    ExprOp op;
+    ExprOperand dst, a, b, c;
+};
+
+class Expression {
+public:
+    static constexpr size_t kBatchSize = 1024;
+    static constexpr uint16_t kRowTemps = 32;   // 单行求值时栈上临时寄存器的个数
+    static constexpr int kMaxDepth = 1000;       // 括号/一元运算的嵌套层数与语法树高度上限，防止递归爆栈
+    static constexpr size_t kMaxOperands = 65535;  // 变量、常量、临时寄存器各自的上限（uint16_t 下标）
+
+    // 解析失败（语法错误、未知变量、嵌套过深、操作数过多）时抛出 std::invalid_argument
+    Expression(std::string_view source, std::vector<std::string> variables = {})
+        : variables(std::move(variables)) {
+        if (this->variables.size() > kMaxOperands) {
+            throw std::invalid_argument("变量个数超过上限");
+        }
+        Parser parser{source, this->variables, nodes};
+        int root = parser.parse();
+        ExprOperand result = generate(root);
+        // 最后一条指令直接写输出列，省去一次拷贝
+        if (result.kind == ExprOperand::TEMP && !code.empty()) {
+            code.back().dst = {ExprOperand::OUTPUT, 0};
+        } else {
+            code.push_back({ExprOp::COPY, {ExprOperand::OUTPUT, 0}, result, result, result});
+        }
+        for (double value : constants) {
+            broadcast.insert(broadcast.end(), kBatchSize, value);
+        }
+    }
+
+    size_t instruction_count() const { return code.size(); }
+    const std::vector<std::string>& variable_names() const { return variables; }
+
+    // columns[i] 对应第 i 个变量，每列 rows 个值；结果写入 out。
+    // threads > 1 时按批次切分行区间并行求值
+    void evaluate(const std::vector<const double*>& columns, double* out, size_t rows,
+                  unsigned threads = 1) const {
+        if (columns.size() != variables.size()) {
+            throw std::invalid_argument("输入列数与变量个数不一致");
+        }
+        size_t batches = (rows + kBatchSize - 1) / kBatchSize;
+        threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, batches)));
+        auto run = [&](size_t first_batch, size_t last_batch) {
+            std::vector<double> temps(temp_count * kBatchSize);
+            for (size_t batch = first_batch; batch < last_batch; ++batch) {
+                size_t begin = batch * kBatchSize;
+                execute(columns, out, temps.data(), begin, std::min(kBatchSize, rows - begin));
+            }
+        };
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back(run, batches * t / threads, batches * (t + 1) / threads);
+        }
+        run(0, batches / threads);
+        for (auto& worker : workers) worker.join();
+    }
+
+    // 单行求值，values[i] 对应第 i 个变量
+    double evaluate(const std::vector<double>& values = {}) const {
+        if (values.size() != variables.size()) {
+            throw std::invalid_argument("输入值个数与变量个数不一致");
+        }
+        return evaluate_row(values.data());
+    }
+
+    // 单行标量解释：临时寄存器放在栈上，常量直接取 constants，不分配内存也不走批量路径
+    double evaluate_row(const double* values) const {
+        double local[kRowTemps];
+        std::vector<double> spill;
+        double* temps = local;
+        if (temp_count > kRowTemps) {
+            spill.resize(temp_count);
+            temps = spill.data();
+        }
+        double result = 0;
+        auto load = [&](ExprOperand operand) -> double {
+            switch (operand.kind) {
+                case ExprOperand::COLUMN: return values[operand.index];
+                case ExprOperand::CONSTANT: return constants[operand.index];
+                case ExprOperand::TEMP: return temps[operand.index];
+                default: return result;
+            }
+        };
+        for (const ExprInstruction& ins : code) {
+            double a = load(ins.a);
+            double value = a;
+            switch (ins.op) {
+                case ExprOp::COPY:    break;
+                case ExprOp::NEG:     value = -a; break;
+                case ExprOp::ADD:     value = a + load(ins.b); break;
+                case ExprOp::SUB:     value = a - load(ins.b); break;
+                case ExprOp::MUL:     value = a * load(ins.b); break;
+                case ExprOp::DIV:     value = a / load(ins.b); break;
+                case ExprOp::MUL_ADD: value = a * load(ins.b) + load(ins.c); break;
+                case ExprOp::MUL_SUB: value = a * load(ins.b) - load(ins.c); break;
+            }
+            (ins.dst.kind == ExprOperand::OUTPUT ? result : temps[ins.dst.index]) = value;
+        }
+        return result;
+    }
+
+    std::string disassemble() const {
+        static const char* const names[] = {"copy", "neg", "add", "sub", "mul", "div", "mul_add", "mul_sub"};
+        static const int arity[] = {1, 1, 2, 2, 2, 2, 3, 3};
+        std::string text;
+        for (size_t i = 0; i < code.size(); ++i) {
+            const ExprInstruction& ins = code[i];
+            int op = static_cast<int>(ins.op);
+            text += "  " + std::to_string(i) + ": " + names[op] + " " + operand_name(ins.dst);
+            const ExprOperand* operands[] = {&ins.a, &ins.b, &ins.c};
+            for (int k = 0; k < arity[op]; ++k) text += ", " + operand_name(*operands[k]);
+            text += "\n";
+        }
+        return text;
+    }
+
+private:
+    struct Node {
+        enum Kind { NUMBER, VARIABLE, NEGATE, BINARY } kind;
+        char op;
+        double value;
+        int variable;
+        int lhs, rhs;
+        int height = 1;
+    };
+
+    // 递归下降解析：expr := term (('+'|'-') term)*
+    //              term := unary (('*'|'/') unary)*
+    //              unary := ('-'|'+') unary | number | name | '(' expr ')'
+    struct Parser {
+        std::string_view source;
+        const std::vector<std::string>& variables;
+        std::vector<Node>& nodes;
+        size_t pos = 0;
+        int nesting = 0;
+
+        int parse() {
+            int root = parse_expr();
+            skip_spaces();
+            if (pos != source.size()) fail("多余的字符");
+            return root;
+        }
+
+        [[noreturn]] void fail(const std::string& what) const {
+            throw std::invalid_argument(what + "（位置 " + std::to_string(pos) + "）");
+        }
+
+        void skip_spaces() {
+            while (pos < source.size() && std::isspace(static_cast<unsigned char>(source[pos]))) ++pos;
+        }
+
+        bool accept(char c) {
+            skip_spaces();
+            if (pos < source.size() && source[pos] == c) {
+                ++pos;
+                return true;
+            }
+            return false;
+        }
+
+        // 记录子树高度：左结合的长链（a + b + c + ...）不经过递归解析，但生成代码时会递归
+        int add(Node node) {
+            if (node.lhs >= 0) node.height = std::max(node.height, nodes[node.lhs].height + 1);
+            if (node.rhs >= 0) node.height = std::max(node.height, nodes[node.rhs].height + 1);
+            if (node.height > kMaxDepth) fail("表达式嵌套过深");
+            nodes.push_back(node);
+            return static_cast<int>(nodes.size() - 1);
+        }
+
+        int number(double value) { return add({Node::NUMBER, 0, value, -1, -1, -1}); }
+
+        // 两侧都是常量时直接折叠
+        int binary(char op, int lhs, int rhs) {
+            if (nodes[lhs].kind == Node::NUMBER && nodes[rhs].kind == Node::NUMBER) {
+                double a = nodes[lhs].value, b = nodes[rhs].value;
+                switch (op) {
+                    case '+': return number(a + b);
+                    case '-': return number(a - b);
+                    case '*': return number(a * b);
+                    default: return number(a / b);
+                }
+            }
+            return add({Node::BINARY, op, 0, -1, lhs, rhs});
+        }
+
+        template<typename F>
+        int nested(F parse_inner) {
+            if (++nesting > kMaxDepth) fail("表达式嵌套过深");
+            int result = parse_inner();
+            --nesting;
+            return result;
+        }
+
+        int parse_expr() {
+            int lhs = parse_term();
+            while (true) {
+                if (accept('+')) lhs = binary('+', lhs, parse_term());
+                else if (accept('-')) lhs = binary('-', lhs, parse_term());
+                else return lhs;
+            }
+        }
+
+        int parse_term() {
+            int lhs = parse_unary();
+            while (true) {
+                if (accept('*')) lhs = binary('*', lhs, parse_unary());
+                else if (accept('/')) lhs = binary('/', lhs, parse_unary());
+                else return lhs;
+            }
+        }
+
+        int parse_unary() {
+            if (accept('+')) return nested([&] { return parse_unary(); });
+            if (accept('-')) {
+                int operand = nested([&] { return parse_unary(); });
+                if (nodes[operand].kind == Node::NUMBER) return number(-nodes[operand].value);
+                return add({Node::NEGATE, '-', 0, -1, operand, -1});
+            }
+            if (accept('(')) {
+                int inner = nested([&] { return parse_expr(); });
+                if (!accept(')')) fail("缺少右括号");
+                return inner;
+            }
+            skip_spaces();
+            if (pos >= source.size()) fail("表达式不完整");
+            char c = source[pos];
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+                std::string text(source.substr(pos));
+                char* end = nullptr;
+                double value = std::strtod(text.c_str(), &end);
+                if (end == text.c_str()) fail("无效的数字");
+                pos += static_cast<size_t>(end - text.c_str());
+                return number(value);
+            }
+            if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                size_t start = pos;
+                while (pos < source.size() &&
+                       (std::isalnum(static_cast<unsigned char>(source[pos])) || source[pos] == '_')) {
+                    ++pos;
+                }
+                std::string_view name = source.substr(start, pos - start);
+                auto it = std::find(variables.begin(), variables.end(), name);
+                if (it == variables.end()) fail("未知变量 " + std::string(name));
+                return add({Node::VARIABLE, 0, 0, static_cast<int>(it - variables.begin()), -1, -1});
+            }
+            fail(std::string("意外的字符 '") + c + "'");
+        }
+    };
+
+    std::vector<std::string> variables;
+    std::vector<Node> nodes;
+    std::vector<ExprInstruction> code;
+    std::vector<double> constants;
+    std::vector<double> broadcast;      // 每个常量重复 kBatchSize 次
+    std::vector<uint16_t> free_temps;
+    uint16_t temp_count = 0;
+
+    // 按位比较去重：0.0 与 -0.0 用 == 比较相等，但 x / 0.0 与 x / -0.0 的符号不同
+    ExprOperand constant(double value) {
+        auto it = std::find_if(constants.begin(), constants.end(), [value](double c) {
+            return std::memcmp(&c, &value, sizeof(double)) == 0;
+        });
+        if (it == constants.end()) {
+            if (constants.size() >= kMaxOperands) throw std::invalid_argument("常量个数超过上限");
+            it = constants.insert(constants.end(), value);
+        }
+        return {ExprOperand::CONSTANT, static_cast<uint16_t>(it - constants.begin())};
+    }
+
+    // 临时寄存器按栈方式复用：表达式树中每个中间结果只被使用一次
+    ExprOperand allocate() {
+        if (!free_temps.empty()) {
+            uint16_t index = free_temps.back();
+            free_temps.pop_back();
+            return {ExprOperand::TEMP, index};
+        }
+        if (temp_count >= kMaxOperands) throw std::invalid_argument("临时寄存器个数超过上限");
+        return {ExprOperand::TEMP, temp_count++};
+    }
+
+    void release(ExprOperand operand) {
+        if (operand.kind == ExprOperand::TEMP) free_temps.push_back(operand.index);
+    }
+
+    // 先分配目标再释放源操作数：目标与源不重叠，编译器的运行时别名检查总能走向量化路径
+    ExprOperand emit(ExprOp op, ExprOperand a, ExprOperand b, ExprOperand c) {
+        ExprOperand dst = allocate();
+        code.push_back({op, dst, a, b, c});
+        release(a);
+        if (b.kind != a.kind || b.index != a.index) release(b);
+        if ((c.kind != a.kind || c.index != a.index) && (c.kind != b.kind || c.index != b.index)) release(c);
+        return dst;
+    }
+
+    bool is_multiply(int node) const {
+        return nodes[node].kind == Node::BINARY && nodes[node].op == '*';
+    }
+
+    ExprOperand generate(int index) {
+        const Node& node = nodes[index];
+        switch (node.kind) {
+            case Node::NUMBER:
+                return constant(node.value);
+            case Node::VARIABLE:
+                return {ExprOperand::COLUMN, static_cast<uint16_t>(node.variable)};
+            case Node::NEGATE: {
+                ExprOperand a = generate(node.lhs);
+                return emit(ExprOp::NEG, a, a, a);
+            }
+            case Node::BINARY:
+                break;
+        }
+        // 融合：x * y + z、z + x * y → mul_add；x * y - z → mul_sub
+        if (node.op == '+' || node.op == '-') {
+            int mul = -1, other = -1;
+            if (is_multiply(node.lhs)) {
+                mul = node.lhs;
+                other = node.rhs;
+            } else if (node.op == '+' && is_multiply(node.rhs)) {
+                mul = node.rhs;
+                other = node.lhs;
+            }
+            if (mul >= 0) {
+                ExprOperand x = generate(nodes[mul].lhs);
+                ExprOperand y = generate(nodes[mul].rhs);
+                ExprOperand z = generate(other);
+                return emit(node.op == '+' ? ExprOp::MUL_ADD : ExprOp::MUL_SUB, x, y, z);
+            }
+        }
+        ExprOperand a = generate(node.lhs);
+        ExprOperand b = generate(node.rhs);
+        ExprOp op = node.op == '+' ? ExprOp::ADD : node.op == '-' ? ExprOp::SUB
+                  : node.op == '*' ? ExprOp::MUL : ExprOp::DIV;
+        return emit(op, a, b, b);
+    }
+
+    std::string operand_name(ExprOperand operand) const {
+        switch (operand.kind) {
+            case ExprOperand::COLUMN: return variables[operand.index];
+            case ExprOperand::CONSTANT: {
+                std::string text = std::to_string(constants[operand.index]);
+                text.erase(text.find_last_not_of('0') + 1);
+                if (text.back() == '.') text.pop_back();
+                return text;
+            }
+            case ExprOperand::TEMP: return "t" + std::to_string(operand.index);
+            default: return "out";
+        }
+    }
+
+    void execute(const std::vector<const double*>& columns, double* out, double* temps,
+                 size_t begin, size_t n) const {
+        auto source = [&](ExprOperand operand) -> const double* {
+            switch (operand.kind) {
+                case ExprOperand::COLUMN: return columns[operand.index] + begin;
+                case ExprOperand::CONSTANT: return broadcast.data() + operand.index * kBatchSize;
+                case ExprOperand::TEMP: return temps + operand.index * kBatchSize;
+                default: return out + begin;
+            }
+        };
+        for (const ExprInstruction& ins : code) {
+            double* dst = ins.dst.kind == ExprOperand::OUTPUT ? out + begin : temps + ins.dst.index * kBatchSize;
+            const double* a = source(ins.a);
+            const double* b = source(ins.b);
+            const double* c = source(ins.c);
+            switch (ins.op) {
+                case ExprOp::COPY:    for (size_t i = 0; i < n; ++i) dst[i] = a[i]; break;
+                case ExprOp::NEG:     for (size_t i = 0; i < n; ++i) dst[i] = -a[i]; break;
+                case ExprOp::ADD:     for (size_t i = 0; i < n; ++i) dst[i] = a[i] + b[i]; break;
+                case ExprOp::SUB:     for (size_t i = 0; i < n; ++i) dst[i] = a[i] - b[i]; break;
+                case ExprOp::MUL:     for (size_t i = 0; i < n; ++i) dst[i] = a[i] * b[i]; break;
+                case ExprOp::DIV:     for (size_t i = 0; i < n; ++i) dst[i] = a[i] / b[i]; break;
+                case ExprOp::MUL_ADD: for (size_t i = 0; i < n; ++i) dst[i] = a[i] * b[i] + c[i]; break;
+                case ExprOp::MUL_SUB: for (size_t i = 0; i < n; ++i) dst[i] = a[i] * b[i] - c[i]; break;
+            }
+        }
+    }
+};
+
+#endif // EXPRESSION_H
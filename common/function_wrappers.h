@@ -0,0 +1,155 @@
+#ifndef FUNCTION_WRAPPERS_H
+#define FUNCTION_WRAPPERS_H
+
+// 不分配堆内存的可调用对象包装器
+// - function_ref<R(Args...)>：不拥有可调用对象，只保存其地址和一个跳转函数，
+//   适合作为参数传递"调用期间有效"的回调，拷贝开销等同两个指针
+// - inplace_function<R(Args...), Capacity>：拥有可调用对象，存放在内部固定大小的缓冲区中，
+//   装不下时编译期报错，任何情况下都不会分配堆内存
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature>
+class function_ref;
+
+template<typename R, typename... Args>
+class function_ref<R(Args...)> {
+private:
+    void* object = nullptr;
+    R (*callback)(void*, Args...) = nullptr;
+
+    template<typename F>
+    static R call_object(void* obj, Args... args) {
+        return std::invoke(*static_cast<F*>(obj), std::forward<Args>(args)...);
+    }
+
+    template<typename F>
+    static R call_function(void* fn, Args... args) {
+        return std::invoke(reinterpret_cast<F*>(fn), std::forward<Args>(args)...);
+    }
+
+public:
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, function_ref> &&
+                                         std::is_invocable_r_v<R, F&, Args...>>>
+    function_ref(F&& f) noexcept {
+        using Fn = std::remove_reference_t<F>;
+        if constexpr (std::is_function_v<Fn>) {
+            object = reinterpret_cast<void*>(&f);
+            callback = &call_function<Fn>;
+        } else {
+            object = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+            callback = &call_object<Fn>;
+        }
+    }
+
+    function_ref(const function_ref&) noexcept = default;
+    function_ref& operator=(const function_ref&) noexcept = default;
+
+    R operator()(Args... args) const {
+        return callback(object, std::forward<Args>(args)...);
+    }
+};
+
+template<typename Signature, std::size_t Capacity = 32,
+         std::size_t Alignment = alignof(std::max_align_t)>
+class inplace_function;
+
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment>
+class inplace_function<R(Args...), Capacity, Alignment> {
+private:
+    // 每种可调用类型一张静态操作表
+    struct VTable {
+        R (*invoke)(void*, Args...);
+        void (*copy)(void* dst, const void* src);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<typename F>
+    static constexpr VTable vtable_for{
+        [](void* self, Args... args) -> R {
+            return std::invoke(*static_cast<F*>(self), std::forward<Args>(args)...);
+        },
+        [](void* dst, const void* src) { new (dst) F(*static_cast<const F*>(src)); },
+        [](void* dst, void* src) noexcept {
+            new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* self) noexcept { static_cast<F*>(self)->~F(); }
+    };
+
+    alignas(Alignment) unsigned char storage[Capacity];
+    const VTable* vtable = nullptr;
+
+public:
+    inplace_function() noexcept = default;
+    inplace_function(std::nullptr_t) noexcept {}
+
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, inplace_function> &&
+                                         std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    inplace_function(F&& f) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Capacity, "可调用对象超出 inplace_function 的内联容量");
+        static_assert(alignof(Fn) <= Alignment, "可调用对象的对齐要求超出 inplace_function");
+        static_assert(std::is_copy_constructible_v<Fn>, "inplace_function 要求可调用对象可拷贝");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "inplace_function 要求可调用对象的移动不抛异常");
+        new (storage) Fn(std::forward<F>(f));
+        vtable = &vtable_for<Fn>;
+    }
+
+    inplace_function(const inplace_function& other) : vtable(other.vtable) {
+        if (vtable) vtable->copy(storage, other.storage);
+    }
+
+    inplace_function(inplace_function&& other) noexcept : vtable(other.vtable) {
+        if (vtable) {
+            vtable->move(storage, other.storage);
+            other.vtable = nullptr;
+        }
+    }
+
+    inplace_function& operator=(const inplace_function& other) {
+        if (this != &other) {
+            inplace_function copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    inplace_function& operator=(inplace_function&& other) noexcept {
+        if (this != &other) {
+            reset();
+            vtable = other.vtable;
+            if (vtable) {
+                vtable->move(storage, other.storage);
+                other.vtable = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~inplace_function() { reset(); }
+
+    void reset() noexcept {
+        if (vtable) {
+            vtable->destroy(storage);
+            vtable = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept { return vtable != nullptr; }
+
+    R operator()(Args... args) const {
+        if (!vtable) throw std::bad_function_call();
+        return vtable->invoke(const_cast<unsigned char*>(storage), std::forward<Args>(args)...);
+    }
+};
+
+#endif // FUNCTION_WRAPPERS_H
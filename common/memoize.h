@@ -0,0 +1,256 @@
+#ifndef MEMOIZE_H
+#define MEMOIZE_H
+
+// 记忆化工具
+// - MemoCache：哈希表 + 可选 LRU 容量上限，LRU 链表直接穿过哈希表节点
+// - Memoizer：缓存归实例所有，被包装的函数可通过 self 递归，内部调用同样命中缓存
+// - ConcurrentMemoizer：按键哈希分片加锁，供多线程共享
+// - memoize：返回可拷贝的函数对象，拷贝之间共享同一个 Memoizer
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 元组键的哈希：逐个元素 std::hash 后混合
+struct TupleHash {
+    template<typename... Ts>
+    std::size_t operator()(const std::tuple<Ts...>& key) const {
+        std::size_t seed = 0;
+        std::apply([&seed](const auto&... parts) {
+            ((seed ^= std::hash<std::decay_t<decltype(parts)>>{}(parts) + 0x9e3779b97f4a7c15ULL
+                      + (seed << 6) + (seed >> 2)), ...);
+        }, key);
+        return seed;
+    }
+};
+
+// 记忆化缓存：哈希表 + 可选的 LRU 容量上限（capacity 为 0 表示不限）。
+// LRU 链表直接穿过哈希表节点（unordered_map 的元素地址在重哈希时不变），不额外分配。
+template<typename Key, typename Value, typename Hash = TupleHash>
+class MemoCache {
+private:
+    struct Entry {
+        Value value;
+        const Key* key = nullptr;
+        Entry* prev = nullptr;
+        Entry* next = nullptr;
+    };
+
+    std::unordered_map<Key, Entry, Hash> table;
+    std::size_t capacity;
+    Entry* head = nullptr;   // 最近使用
+    Entry* tail = nullptr;   // 最久未使用
+    std::size_t hit_count = 0;
+    std::size_t miss_count = 0;
+
+    void unlink(Entry* e) {
+        (e->prev ? e->prev->next : head) = e->next;
+        (e->next ? e->next->prev : tail) = e->prev;
+    }
+
+    void push_front(Entry* e) {
+        e->prev = nullptr;
+        e->next = head;
+        (head ? head->prev : tail) = e;
+        head = e;
+    }
+
+public:
+    explicit MemoCache(std::size_t capacity = 0) : capacity(capacity) {
+        if (capacity) table.reserve(capacity + 1);
+    }
+
+    // 链表指针指向 table 自己的节点，逐元素复制后会指回源对象，因此禁止复制。
+    // 移动时 unordered_map 整体接管节点，地址不变，只需把源对象的链表头尾置空
+    MemoCache(const MemoCache&) = delete;
+    MemoCache& operator=(const MemoCache&) = delete;
+
+    MemoCache(MemoCache&& other) noexcept
+        : table(std::move(other.table)), capacity(other.capacity),
+          head(std::exchange(other.head, nullptr)), tail(std::exchange(other.tail, nullptr)),
+          hit_count(other.hit_count), miss_count(other.miss_count) {
+        other.table.clear();
+    }
+
+    MemoCache& operator=(MemoCache&& other) noexcept {
+        if (this != &other) {
+            table = std::move(other.table);
+            capacity = other.capacity;
+            head = std::exchange(other.head, nullptr);
+            tail = std::exchange(other.tail, nullptr);
+            hit_count = other.hit_count;
+            miss_count = other.miss_count;
+            other.table.clear();
+        }
+        return *this;
+    }
+
+    // 命中时只查一次表
+    const Value* find(const Key& key) {
+        auto it = table.find(key);
+        if (it == table.end()) {
+            ++miss_count;
+            return nullptr;
+        }
+        ++hit_count;
+        if (capacity && head != &it->second) {
+            unlink(&it->second);
+            push_front(&it->second);
+        }
+        return &it->second.value;
+    }
+
+    // 插入计算结果，超出容量时淘汰最久未使用的项
+    const Value& insert(const Key& key, Value value) {
+        auto [it, inserted] = table.try_emplace(key);
+        Entry& e = it->second;
+        e.value = std::move(value);
+        if (capacity && inserted) {
+            e.key = &it->first;
+            push_front(&e);
+            if (table.size() > capacity) {
+                Entry* victim = tail;
+                unlink(victim);
+                Key victim_key = *victim->key;
+                table.erase(victim_key);
+            }
+        }
+        return e.value;
+    }
+
+    void clear() {
+        table.clear();
+        head = tail = nullptr;
+    }
+
+    std::size_t size() const { return table.size(); }
+    std::size_t hits() const { return hit_count; }
+    std::size_t misses() const { return miss_count; }
+};
+
+// 记忆化装饰器：缓存归每个 Memoizer 实例所有。
+// 函数可以接收 Memoizer& 作为第一个参数，内部递归调用经过同一缓存。
+template<typename Result, typename... Args>
+class Memoizer {
+public:
+    using Key = std::tuple<std::decay_t<Args>...>;
+
+private:
+    MemoCache<Key, Result> cache;
+    std::function<Result(Memoizer&, Args...)> func;
+
+    template<typename F>
+    static std::function<Result(Memoizer&, Args...)> adapt(F f) {
+        if constexpr (std::is_invocable_v<F&, Memoizer&, Args...>) {
+            return f;
+        } else {
+            return [f](Memoizer&, Args... args) { return f(args...); };
+        }
+    }
+
+public:
+    template<typename F>
+    explicit Memoizer(F f, std::size_t capacity = 0) : cache(capacity), func(adapt(std::move(f))) {}
+
+    Result operator()(Args... args) {
+        Key key(args...);
+        if (const Result* cached = cache.find(key)) {
+            return *cached;
+        }
+        // 先计算再插入：递归期间的插入或淘汰不会影响本次结果
+        Result result = func(*this, args...);
+        return cache.insert(key, std::move(result));
+    }
+
+    const MemoCache<Key, Result>& stats() const { return cache; }
+    void clear() { cache.clear(); }
+};
+
+// 分片并发版本：按键的哈希选择分片，每个分片一把锁；
+// 计算在锁外进行，同一个键可能被并发计算多次，但结果一致
+template<typename Result, typename... Args>
+class ConcurrentMemoizer {
+public:
+    using Key = std::tuple<std::decay_t<Args>...>;
+
+private:
+    static constexpr std::size_t kShards = 16;
+
+    struct alignas(64) Shard {
+        std::mutex mtx;
+        MemoCache<Key, Result> cache;
+        explicit Shard(std::size_t capacity) : cache(capacity) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::function<Result(ConcurrentMemoizer&, Args...)> func;
+
+    Shard& shard_for(const Key& key) {
+        std::size_t h = TupleHash{}(key);
+        return *shards[(h ^ (h >> 32)) % kShards];
+    }
+
+    template<typename F>
+    static std::function<Result(ConcurrentMemoizer&, Args...)> adapt(F f) {
+        if constexpr (std::is_invocable_v<F&, ConcurrentMemoizer&, Args...>) {
+            return f;
+        } else {
+            return [f](ConcurrentMemoizer&, Args... args) { return f(args...); };
+        }
+    }
+
+public:
+    // capacity 为每个分片的 LRU 上限
+    template<typename F>
+    explicit ConcurrentMemoizer(F f, std::size_t capacity_per_shard = 0) : func(adapt(std::move(f))) {
+        for (std::size_t i = 0; i < kShards; ++i) {
+            shards.push_back(std::make_unique<Shard>(capacity_per_shard));
+        }
+    }
+
+    Result operator()(Args... args) {
+        Key key(args...);
+        Shard& shard = shard_for(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            if (const Result* cached = shard.cache.find(key)) {
+                return *cached;
+            }
+        }
+        Result result = func(*this, args...);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        return shard.cache.insert(key, std::move(result));
+    }
+
+    std::size_t size() {
+        std::size_t total = 0;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->mtx);
+            total += shard->cache.size();
+        }
+        return total;
+    }
+};
+
+// 返回的函数对象持有 shared_ptr<Memoizer>，拷贝之间共享缓存；每次 memoize 得到独立的缓存
+template<typename Result, typename... Args, typename Func>
+auto memoize(Func func, std::size_t capacity = 0) {
+    using Memo = Memoizer<Result, Args...>;
+
+    struct Memoized {
+        std::shared_ptr<Memo> memo;
+
+        Result operator()(Args... args) const { return (*memo)(args...); }
+        std::size_t cache_size() const { return memo->stats().size(); }
+    };
+
+    return Memoized{std::make_shared<Memo>(std::move(func), capacity)};
+}
+
+#endif // MEMOIZE_H